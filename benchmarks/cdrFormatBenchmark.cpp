@@ -0,0 +1,120 @@
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "cdrFormatter.hpp"
+
+/**
+ * @file cdrFormatBenchmark.cpp
+ * @brief Сравнение скорости форматирования CDR через std::ostringstream и через CdrFormatter.
+ */
+
+namespace {
+/**
+ * @brief Прежний способ форматирования: localtime и std::put_time на каждую метку времени,
+ * std::to_string и std::string для статуса.
+ */
+void legacyAppendCDR(std::string& out, const CDR& cdr) {
+    out += utility::prepareTime(cdr.startTime);
+    out += ';';
+    out += std::to_string(cdr.callID);
+    out += ';';
+    out += cdr.number.view();
+    out += ';';
+    out += utility::prepareTime(cdr.endTime);
+    out += ';';
+    out += utility::to_string(cdr.status);
+    out += ';';
+    out += utility::prepareTime(cdr.operatorCallTime);
+    out += ';';
+    out += std::to_string(cdr.operatorID);
+    out += ';';
+    out += std::to_string(cdr.callDuration.count());
+    out += 's';
+}
+
+std::vector<CDR> makeRecords(std::size_t count) {
+    static const std::string number = "89001234567";
+    auto time = std::chrono::system_clock::now();
+    std::vector<CDR> records(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        auto& cdr = records[i];
+        cdr.startTime = time + std::chrono::milliseconds{static_cast<int>(i)};
+        cdr.operatorCallTime = cdr.startTime + std::chrono::milliseconds{150};
+        cdr.endTime = cdr.operatorCallTime + std::chrono::seconds{5};
+        cdr.callID = 1000000 + i;
+        cdr.number = number;
+        cdr.status = CallStatus::Completed;
+        cdr.operatorID = i % 16;
+        cdr.callDuration = std::chrono::seconds{5};
+    }
+    return records;
+}
+
+void BM_LegacyFormat(benchmark::State& state) {
+    auto records = makeRecords(1024);
+    std::string batch;
+    for (auto _: state) {
+        batch.clear();
+        for (const auto& cdr: records) {
+            legacyAppendCDR(batch, cdr);
+            batch += '\n';
+        }
+        benchmark::DoNotOptimize(batch.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * records.size()));
+}
+BENCHMARK(BM_LegacyFormat);
+
+void BM_CdrFormatter(benchmark::State& state) {
+    auto records = makeRecords(1024);
+    utility::CdrFormatter formatter;
+    std::vector<char> buffer(records.size() * utility::CdrFormatter::maxSize(records.front()));
+    for (auto _: state) {
+        auto* out = buffer.data();
+        for (const auto& cdr: records) {
+            out = formatter.format(out, buffer.data() + buffer.size(), cdr);
+            *out++ = '\n';
+        }
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * records.size()));
+}
+BENCHMARK(BM_CdrFormatter);
+
+void BM_AppendCDR(benchmark::State& state) {
+    auto records = makeRecords(1024);
+    std::string batch;
+    for (auto _: state) {
+        batch.clear();
+        for (const auto& cdr: records) {
+            utility::appendCDR(batch, cdr);
+            batch += '\n';
+        }
+        benchmark::DoNotOptimize(batch.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * records.size()));
+}
+BENCHMARK(BM_AppendCDR);
+
+void BM_OfstreamCDR(benchmark::State& state) {
+    auto records = makeRecords(1024);
+    auto path = std::filesystem::temp_directory_path() / "protei_cov_benchmark_cdr.txt";
+    std::ofstream file(path, std::ios::trunc);
+    for (auto _: state) {
+        file.seekp(0);
+        for (const auto& cdr: records) {
+            file << cdr;
+            file << '\n';
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * records.size()));
+    file.close();
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_OfstreamCDR);
+}
@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "jsonParser.hpp"
+
+/**
+ * @file jsonParserBenchmark.cpp
+ * @brief Стоимость чтения файла конфигурации: JsonParser::parse и преобразование в словарь параметров.
+ */
+
+namespace {
+std::filesystem::path writeConfig() {
+    auto path = std::filesystem::temp_directory_path() / "protei_cov_benchmark_config.json";
+    std::ofstream file(path);
+    file << R"({
+    "RMin": 10,
+    "RMax": 15,
+    "AmountOfOperators": 5,
+    "SizeOfQueue": 15,
+    "KeepAliveTimeout": 5,
+    "MaxRequestsPerConnection": 100,
+    "QueueType": 0,
+    "OperatorMode": 0,
+    "CdrDurability": 1,
+    "CdrFlushInterval": 50,
+    "CdrBatchSize": 65536,
+    "NodeID": 0,
+    "LogLevel": 1,
+    "LogOverflowPolicy": 0
+})";
+    return path;
+}
+
+void BM_JsonParserParse(benchmark::State& state) {
+    auto path = writeConfig();
+    utility::JsonParser parser(nullptr);
+    for (auto _: state) {
+        parser.parse(path);
+        auto config = parser.outputConfig();
+        benchmark::DoNotOptimize(config.size());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_JsonParserParse);
+}
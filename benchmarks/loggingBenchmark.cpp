@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+
+#include <spdlog/async.h>
+#include <spdlog/sinks/null_sink.h>
+#include <string>
+#include <vector>
+
+#include "task.hpp"
+#include "threadpool.hpp"
+
+/**
+ * @file loggingBenchmark.cpp
+ * @brief Пропускная способность пула потоков (вызовов в секунду) при разных уровнях логирования.
+ * Логгер асинхронный, как в сервере, но пишет в null_sink, поэтому измеряется только стоимость
+ * формирования сообщений и передачи их в очередь логгера. Уровень, вырезанный при компиляции
+ * (LOG_ACTIVE_LEVEL), стоит столько же, сколько off.
+ */
+
+namespace {
+constexpr std::size_t callsPerBatch = 512;
+
+std::shared_ptr<spdlog::logger> makeLogger(spdlog::level::level_enum level) {
+    static auto pool = std::make_shared<spdlog::details::thread_pool>(8192, 1);
+    auto logger = std::make_shared<spdlog::async_logger>("loggingBenchmark",
+                                                         std::make_shared<spdlog::sinks::null_sink_mt>(), pool,
+                                                         spdlog::async_overflow_policy::block);
+    logger->set_level(level);
+    return logger;
+}
+
+void BM_CallsAtLogLevel(benchmark::State& state) {
+    auto level = static_cast<spdlog::level::level_enum>(state.range(0));
+    auto logger = makeLogger(level);
+    TP::ThreadPool pool(4, static_cast<unsigned>(callsPerBatch));
+    pool.setLogger(logger);
+    pool.start();
+
+    std::vector<std::string> numbers(callsPerBatch);
+    std::vector<std::future<Result>> futures;
+    futures.reserve(callsPerBatch);
+    std::size_t next = 0;
+    for (auto _: state) {
+        futures.clear();
+        auto now = std::chrono::system_clock::now();
+        for (auto& number: numbers) {
+            number = std::to_string(next++);
+            // RMax = 0: вызов сразу завершается по таймауту, логирование по пути вызова то же, без сна.
+            futures.push_back(pool.add_task(std::make_shared<TP::Task>(0, 0, number, now, logger)).second);
+        }
+        for (auto& future: futures)
+            benchmark::DoNotOptimize(future.get());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * callsPerBatch));
+    state.SetLabel(std::string{spdlog::level::to_string_view(level).data()});
+}
+BENCHMARK(BM_CallsAtLogLevel)
+    ->Arg(spdlog::level::trace)
+    ->Arg(spdlog::level::debug)
+    ->Arg(spdlog::level::info)
+    ->Arg(spdlog::level::warn)
+    ->Arg(spdlog::level::off)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+}
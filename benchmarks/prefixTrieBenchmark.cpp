@@ -0,0 +1,43 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "prefixTrie.hpp"
+
+/**
+ * @file prefixTrieBenchmark.cpp
+ * @brief Стоимость поиска номера в фильтре номеров из сотен тысяч префиксов до и после упаковки дерева.
+ */
+
+namespace {
+std::string randomDigits(std::mt19937& generator, std::size_t length) {
+    std::uniform_int_distribution<int> digit(0, 9);
+    std::string result(length, '0');
+    for (auto& symbol: result)
+        symbol = static_cast<char>('0' + digit(generator));
+    return result;
+}
+
+void BM_PrefixTrieMatch(benchmark::State& state) {
+    std::mt19937 generator(42);
+    utility::PrefixTrie trie;
+    trie.insert("", 1);
+    for (int64_t i = 0; i < state.range(0); ++i)
+        trie.insert("7" + randomDigits(generator, 9), 0);
+    if (state.range(1) != 0)
+        trie.compact();
+
+    std::vector<std::string> numbers;
+    for (int i = 0; i < 4096; ++i)
+        numbers.push_back("7" + randomDigits(generator, 10));
+    std::size_t index = 0;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(trie.match(numbers[index]));
+        index = (index + 1) % numbers.size();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_PrefixTrieMatch)->ArgsProduct({{1000, 300000}, {0, 1}})->ArgNames({"prefixes", "compact"});
+}
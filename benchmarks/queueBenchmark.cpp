@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "queue.hpp"
+#include "task.hpp"
+
+/**
+ * @file queueBenchmark.cpp
+ * @brief Стоимость Queue::push и Queue::pop при разной заполненности очереди и доле повторных вызовов.
+ * Очередь удерживается на заданном уровне: за каждым push следует pop, кроме случаев, когда push заменил
+ * дубликат и размер очереди не изменился.
+ */
+
+namespace {
+constexpr std::size_t tasksPerBatch = 1024;
+
+/**
+ * @brief Писатель CDR, который только считает записи, по ним видно, что push нашел дубликат.
+ */
+class CountingRecorder : public IRecorder {
+public:
+    void makeRecord(const CDR&) override { ++records; }
+    void flush() override {}
+    void setLogger(std::shared_ptr<spdlog::logger>) override {}
+
+    std::size_t records = 0; ///< Количество записей.
+};
+
+void BM_QueuePushPop(benchmark::State& state) {
+    auto fill = static_cast<std::size_t>(state.range(0));
+    auto duplicatePercent = static_cast<unsigned>(state.range(1));
+
+    // Task хранит номер как string_view, поэтому строки номеров живут все время измерения.
+    std::vector<std::string> numbers(4 * fill + 4 * tasksPerBatch);
+    for (std::size_t i = 0; i < numbers.size(); ++i)
+        numbers[i] = std::to_string(89000000000ull + i);
+
+    TP::Queue queue(static_cast<int>(fill + 1));
+    auto recorder = std::make_shared<CountingRecorder>();
+    queue.setRecorders({recorder});
+    // Срок ожидания задач (время поступления плюс RMax) не истекает за время измерения.
+    auto time = std::chrono::system_clock::now();
+    TP::CallID callID = 0;
+    std::size_t fresh = 0;
+    for (; fresh < fill; ++fresh)
+        (void)queue.push({std::make_shared<TP::Task>(0, 3600, numbers[fresh], time, nullptr), ++callID});
+
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<unsigned> percent(0, 99);
+    std::uniform_int_distribution<std::size_t> recent(1, std::max<std::size_t>(fill, 1));
+    std::vector<std::shared_ptr<TP::ITask>> tasks(tasksPerBatch);
+    std::pair<std::shared_ptr<TP::ITask>, TP::CallID> popped;
+    std::size_t pushed = 0;
+    for (auto _: state) {
+        state.PauseTiming();
+        for (auto& task: tasks) {
+            // Дубликат берется среди недавно поставленных номеров, большинство из них еще в очереди.
+            auto index = fill > 0 && percent(rng) < duplicatePercent ? fresh - recent(rng) : fresh++;
+            task = std::make_shared<TP::Task>(0, 3600, numbers[index % numbers.size()], time, nullptr);
+        }
+        state.ResumeTiming();
+        for (auto& task: tasks) {
+            auto records = recorder->records;
+            (void)queue.push({std::move(task), ++callID});
+            if (recorder->records == records)
+                queue.tryPop(popped);
+        }
+        pushed += tasksPerBatch;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(pushed));
+    state.counters["duplicates"] = benchmark::Counter(static_cast<double>(recorder->records),
+                                                      benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_QueuePushPop)
+    ->ArgNames({"fill", "dup%"})
+    ->ArgsProduct({{0, 64, 4096, 65536}, {0, 10, 50}});
+}
@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lockFreeQueue.hpp"
+#include "queue.hpp"
+#include "shardedQueue.hpp"
+#include "task.hpp"
+#include "taskPool.hpp"
+#include "threadpool.hpp"
+
+/**
+ * @file threadPoolBenchmark.cpp
+ * @brief Стоимость создания Task (через make_shared и из TaskPool), генерации CallID и постановки вызовов в ThreadPool несколькими потоками.
+ * Вызовы создаются с RMin = RMax = 0: они сразу завершаются по таймауту, поэтому время разговора
+ * не заслоняет накладные расходы пула.
+ */
+
+namespace {
+constexpr std::size_t callsPerBatch = 4096;
+constexpr unsigned operators = 4;
+
+std::shared_ptr<TP::IQueue> makeQueue(int type) {
+    switch (type) {
+    case 1: return std::make_shared<TP::LockFreeQueue>(static_cast<int>(callsPerBatch));
+    case 2: return std::make_shared<TP::ShardedQueue>(static_cast<int>(callsPerBatch), operators);
+    default: return std::make_shared<TP::Queue>(static_cast<int>(callsPerBatch));
+    }
+}
+
+void BM_ThreadPoolAddTask(benchmark::State& state) {
+    auto producers = static_cast<std::size_t>(state.range(0));
+    TP::ThreadPool pool(operators, static_cast<unsigned>(callsPerBatch));
+    pool.setTaskQueue(makeQueue(static_cast<int>(state.range(1))));
+    pool.start();
+
+    std::vector<std::string> numbers(callsPerBatch);
+    for (std::size_t i = 0; i < numbers.size(); ++i)
+        numbers[i] = std::to_string(89000000000ull + i);
+
+    std::vector<std::thread> threads;
+    for (auto _: state) {
+        auto now = std::chrono::system_clock::now();
+        threads.clear();
+        for (std::size_t p = 0; p < producers; ++p)
+            threads.emplace_back([&pool, &numbers, now, p, producers]() {
+                std::vector<std::future<Result>> futures;
+                futures.reserve(callsPerBatch / producers + 1);
+                for (auto i = p; i < callsPerBatch; i += producers)
+                    futures.push_back(pool.add_task(std::make_shared<TP::Task>(0, 0, numbers[i], now, nullptr)).second);
+                for (auto& future: futures)
+                    benchmark::DoNotOptimize(future.get());
+            });
+        for (auto& thread: threads)
+            thread.join();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * callsPerBatch));
+}
+BENCHMARK(BM_ThreadPoolAddTask)
+    ->ArgNames({"producers", "queue"})
+    ->ArgsProduct({{1, 2, 4, 8}, {0, 1, 2}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_TaskConstruction(benchmark::State& state) {
+    std::string number = "89001234567";
+    auto now = std::chrono::system_clock::now();
+    for (auto _: state) {
+        auto task = std::make_shared<TP::Task>(0, 0, number, now, nullptr);
+        benchmark::DoNotOptimize(task.get());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_TaskConstruction);
+
+void BM_PooledTaskConstruction(benchmark::State& state) {
+    std::string number = "89001234567";
+    auto now = std::chrono::system_clock::now();
+    TP::TaskPool tasks;
+    for (auto _: state) {
+        auto task = tasks.makeTask(0, 0, number, now, nullptr);
+        benchmark::DoNotOptimize(task.get());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_PooledTaskConstruction);
+
+void BM_GenerateCallID(benchmark::State& state) {
+    static TP::CallIdGenerator generator(1);
+    for (auto _: state)
+        benchmark::DoNotOptimize(generator.next());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_GenerateCallID)->ThreadRange(1, 8)->UseRealTime();
+}
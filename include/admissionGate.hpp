@@ -0,0 +1,43 @@
+#ifndef PROTEI_COV_ADMISSIONGATE_HPP
+#define PROTEI_COV_ADMISSIONGATE_HPP
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @file admissionGate.hpp
+ * @brief Содержит объявление класса AdmissionGate
+ */
+
+namespace TP {
+/**
+ * @brief Класс AdmissionGate – счетчик вызовов в работе для ранней проверки перегрузки.
+ * Вызов допускается, если вызовов в работе (в очереди и у операторов) меньше предела,
+ * иначе его можно отклонить до создания задачи, CallID в пуле потоков и мьютекса очереди.
+ * Проверка и увеличение счетчика выполняются одной операцией compare-and-swap без блокировок,
+ * поэтому число допущенных вызовов никогда не превышает предел.
+ */
+class AdmissionGate {
+public:
+    /**
+     * @brief Пытается допустить вызов.
+     * @param limit Максимальное количество вызовов в работе.
+     * @return true, если вызов допущен и по его завершении нужно вызвать leave.
+     */
+    bool tryEnter(std::size_t limit);
+
+    /**
+     * @brief Отмечает завершение допущенного вызова.
+     */
+    void leave();
+
+    /**
+     * @brief Возвращает количество вызовов в работе.
+     * @return Количество допущенных и не завершенных вызовов.
+     */
+    [[nodiscard]] std::size_t inFlight() const;
+
+private:
+    std::atomic<std::size_t> inFlight_{0}; ///< Количество вызовов в работе.
+};
+}
+#endif // PROTEI_COV_ADMISSIONGATE_HPP
@@ -3,6 +3,13 @@
 #include "manager.hpp"
 #include "config.hpp"
 #include "threadpool.hpp"
+#include "queue.hpp"
+#include "priorityQueue.hpp"
+#include "lockFreeQueue.hpp"
+#include "shardedQueue.hpp"
+#include "callMetrics.hpp"
+
+#include <spdlog/async.h>
 
 /**
  * @file builder.hpp
@@ -14,9 +21,16 @@ public:
     /**
      * @brief Метод для создания и настройки асинхронного логгера,
      * сохраняет логгер в локальную переменную.
+     * @param policy Поведение логгера при переполнении очереди сообщений.
      * @return Указатель на асинхронный логгер.
      */
-    std::shared_ptr<spdlog::logger> BuildLogger();
+    std::shared_ptr<spdlog::logger> BuildLogger(spdlog::async_overflow_policy policy = spdlog::async_overflow_policy::block);
+
+    /**
+     * @brief Метод для применения уровня логирования и поведения при переполнении из конфигурации,
+     * при необходимости пересоздает логгер и передает его конфигурации.
+     */
+    void ApplyLogSettings();
 
     /**
      * @brief Метод для создания и настройки объекта конфигурации,
@@ -46,10 +60,33 @@ public:
      * @return Указатель на объект Manager.
      */
     std::shared_ptr<Manager> Construct(const std::filesystem::path& pathToConfig);
+
+    /**
+     * @brief Метод для получения созданного ранее объекта конфигурации.
+     * @return Указатель на объект конфигурации.
+     */
+    std::shared_ptr<utility::ThreadSafeConfig> GetConfig() const;
+
+    /**
+     * @brief Метод для получения созданного ранее логгера.
+     * @return Указатель на асинхронный логгер.
+     */
+    std::shared_ptr<spdlog::logger> GetLogger() const;
+
+    /**
+     * @brief Метод для получения метрик вызовов, созданных вместе с писателями CDR.
+     * @return Указатель на метрики вызовов.
+     */
+    std::shared_ptr<utility::CallMetrics> GetMetrics() const;
+
+    std::shared_ptr<TP::CallIdGenerator> GetCallIdGenerator() const;
 private:
     std::shared_ptr<spdlog::logger> logger; ///< Указатель на асинхронный логгер.
+    std::vector<spdlog::sink_ptr> sinks; ///< Приемники логов, общие для пересоздаваемых логгеров.
     std::shared_ptr<utility::ThreadSafeConfig> config; ///< Указатель на конфиг.
     std::vector<std::shared_ptr<IRecorder>> recorders; ///< Вектор указателей на писателей.
+    std::shared_ptr<utility::CallMetrics> metrics; ///< Метрики вызовов, подключены как писатель CDR.
+    std::shared_ptr<TP::CallIdGenerator> callIdGenerator; ///< Генератор CallID пула потоков.
 };
 
 #endif // PROTEI_COV_BUILDER_HPP
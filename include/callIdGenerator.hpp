@@ -0,0 +1,70 @@
+#ifndef PROTEI_COV_CALLIDGENERATOR_HPP
+#define PROTEI_COV_CALLIDGENERATOR_HPP
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "commonStructures.hpp"
+
+/**
+ * @file callIdGenerator.hpp
+ * @brief Содержит объявление класса CallIdGenerator
+ */
+
+namespace TP {
+/**
+ * @brief Класс CallIdGenerator – генератор CallID по схеме Snowflake.
+ * CallID состоит из 41 бита миллисекунд от эпохи генератора (2024-01-01 UTC, хватает примерно на 69 лет),
+ * 10 бит идентификатора узла и 12 бит номера вызова внутри миллисекунды.
+ * Последний выданный CallID хранится в одном атомарном значении, следующий вычисляется как максимум
+ * из текущего времени и предыдущего CallID плюс один, поэтому генератор без блокировок выдает строго
+ * возрастающие значения, даже если часы отступили назад или за миллисекунду выдано больше 4096 CallID
+ * (тогда значения занимают будущие миллисекунды).
+ * Уникальность между экземплярами обеспечивается разными идентификаторами узла,
+ * между перезапусками – временем, так как перезапуск занимает больше миллисекунды.
+ */
+class CallIdGenerator {
+public:
+    static constexpr unsigned sequenceBits = 12; ///< Разрядность номера вызова внутри миллисекунды.
+    static constexpr unsigned nodeBits = 10; ///< Разрядность идентификатора узла.
+    static constexpr std::uint64_t maxNodeID = (std::uint64_t{1} << nodeBits) - 1; ///< Максимальный идентификатор узла.
+    static constexpr std::chrono::milliseconds epoch{1704067200000}; ///< Эпоха генератора, 2024-01-01 UTC.
+
+    /**
+     * @brief Конструктор класса CallIdGenerator.
+     * @param nodeID Идентификатор узла, берутся младшие 10 бит.
+     */
+    explicit CallIdGenerator(std::uint64_t nodeID = 0);
+
+    /**
+     * @brief Выдает следующий CallID.
+     * @return Уникальный CallID, больший всех выданных ранее этим генератором.
+     */
+    CallID next();
+
+    /**
+     * @brief Возвращает идентификатор узла генератора.
+     * @return Идентификатор узла.
+     */
+    [[nodiscard]] std::uint64_t nodeID() const;
+
+    /**
+     * @brief Извлекает время создания из CallID.
+     * @param id CallID.
+     * @return Время создания с точностью до миллисекунды.
+     */
+    static std::chrono::system_clock::time_point timestamp(CallID id);
+
+    /**
+     * @brief Извлекает идентификатор узла из CallID.
+     * @param id CallID.
+     * @return Идентификатор узла.
+     */
+    static std::uint64_t node(CallID id);
+
+private:
+    std::uint64_t nodeID_; ///< Идентификатор узла.
+    std::atomic<std::uint64_t> last_; ///< Последний выданный CallID без идентификатора узла.
+};
+}
+#endif // PROTEI_COV_CALLIDGENERATOR_HPP
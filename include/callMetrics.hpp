@@ -0,0 +1,91 @@
+#ifndef PROTEI_COV_CALLMETRICS_HPP
+#define PROTEI_COV_CALLMETRICS_HPP
+#include <array>
+#include <atomic>
+#include <functional>
+#include <string>
+
+#include "latencyHistogram.hpp"
+#include "recorder.hpp"
+
+/**
+ * @file callMetrics.hpp
+ * @brief Содержит объявление класса CallMetrics
+ */
+
+namespace utility {
+/**
+ * @brief Класс CallMetrics – метрики жизненного цикла вызова.
+ * Подключается к очереди как еще один писатель CDR, поэтому получает каждую запись, которую пишут
+ * ThreadPool::executeTask (обслуженные вызовы) и IQueue::push (отклоненные вызовы).
+ * По CDR считаются время ожидания в очереди (operatorCallTime - startTime), время обслуживания
+ * (endTime - operatorCallTime) и полное время вызова (endTime - startTime), а также количество вызовов
+ * по статусам. Время обработки HTTP запроса записывает сервер.
+ * Время ожидания дополнительно считается по классам приоритета (CDR::priority). Если очередь
+ * разделена на классы, метрики включают глубину очереди каждого класса.
+ * Метрики выдаются в текстовом формате Prometheus.
+ */
+class CallMetrics : public IRecorder {
+public:
+    /**
+     * @brief Учитывает вызов по его CDR.
+     * @param cdr Структура CDR с данными о вызове.
+     */
+    void makeRecord(const CDR& cdr) override;
+
+    /**
+     * @brief Ничего не делает: метрики не буферизуются.
+     */
+    void flush() override;
+
+    void setLogger(std::shared_ptr<spdlog::logger> logger) override;
+
+    /**
+     * @brief Записывает время обработки HTTP запроса.
+     * @param duration Время от получения запроса до готовности ответа.
+     */
+    void recordHttpRequest(std::chrono::microseconds duration);
+
+    /**
+     * @brief Устанавливает источник глубины очереди по классам приоритета и включает метрики классов.
+     * Вызывается до начала обработки вызовов.
+     * @param depth Функция, возвращающая количество вызовов в очереди класса по его номеру.
+     */
+    void setClassDepth(std::function<std::size_t(PriorityClass)> depth);
+
+    /**
+     * @brief Формирует метрики в текстовом формате Prometheus.
+     * @return Текст для ответа на /metrics.
+     */
+    [[nodiscard]] std::string prometheus() const;
+
+    /// @brief Возвращает гистограмму времени ожидания в очереди.
+    [[nodiscard]] const LatencyHistogram& queueWait() const { return queueWait_; }
+
+    /// @brief Возвращает гистограмму времени обслуживания оператором.
+    [[nodiscard]] const LatencyHistogram& service() const { return service_; }
+
+    /// @brief Возвращает гистограмму полного времени вызова.
+    [[nodiscard]] const LatencyHistogram& endToEnd() const { return endToEnd_; }
+
+    /// @brief Возвращает гистограмму времени обработки HTTP запроса.
+    [[nodiscard]] const LatencyHistogram& httpRequest() const { return httpRequest_; }
+
+    /// @brief Возвращает гистограмму времени ожидания в очереди для класса приоритета.
+    [[nodiscard]] const LatencyHistogram& classQueueWait(PriorityClass priority) const {
+        return classQueueWait_[static_cast<std::size_t>(priority)];
+    }
+
+private:
+    static constexpr std::size_t statusCount = 6; ///< Количество значений CallStatus.
+
+    LatencyHistogram queueWait_; ///< Время ожидания в очереди.
+    LatencyHistogram service_; ///< Время обслуживания оператором.
+    LatencyHistogram endToEnd_; ///< Полное время вызова.
+    LatencyHistogram httpRequest_; ///< Время обработки HTTP запроса.
+    std::array<LatencyHistogram, priorityClassCount> classQueueWait_; ///< Время ожидания в очереди по классам приоритета.
+    std::function<std::size_t(PriorityClass)> classDepth_; ///< Глубина очереди по классам, пусто – классов нет.
+    std::array<std::atomic<std::uint64_t>, statusCount> calls_{}; ///< Количество вызовов по статусам.
+};
+}
+#endif // PROTEI_COV_CALLMETRICS_HPP
@@ -0,0 +1,84 @@
+#ifndef PROTEI_COV_CDRFORMATTER_HPP
+#define PROTEI_COV_CDRFORMATTER_HPP
+#include <array>
+#include <chrono>
+#include <ctime>
+#include <string_view>
+
+#include "commonStructures.hpp"
+
+/**
+ * @file cdrFormatter.hpp
+ * @brief Содержит объявление класса CdrFormatter
+ */
+
+namespace utility {
+/**
+ * @brief Возвращает статическое строковое представление статуса вызова без выделения памяти.
+ * @param status Статус вызова.
+ * @return Строковое представление статуса вызова.
+ */
+std::string_view statusName(CallStatus status);
+
+/**
+ * @brief Класс CdrFormatter – форматирование CDR в буфер вызывающего без выделения памяти.
+ * Числа записываются через std::to_chars, а префикс времени "YYYY-MM-DD HH:MM:SS"
+ * вычисляется через localtime_r один раз на секунду и кэшируется, поэтому форматирование
+ * записи не обращается к глобальной блокировке часового пояса на каждом вызове.
+ * Формат совпадает с operator<<(std::ofstream&, const CDR&).
+ * Объект не потокобезопасен, каждый поток использует свой экземпляр.
+ */
+class CdrFormatter {
+public:
+    /// Размер записи без номера звонящего с запасом.
+    static constexpr std::size_t fixedSize = 160;
+
+    /**
+     * @brief Возвращает размер буфера, достаточный для записи CDR.
+     * @param cdr Запись о вызове.
+     * @return Размер буфера в байтах.
+     */
+    static std::size_t maxSize(const CDR& cdr);
+
+    /**
+     * @brief Форматирует CDR в буфер.
+     * @param first Начало буфера.
+     * @param last Конец буфера.
+     * @param cdr Запись о вызове.
+     * @return Указатель на символ после записи или nullptr, если буфера не хватило.
+     */
+    char* format(char* first, char* last, const CDR& cdr);
+
+    /**
+     * @brief Форматирует момент времени в виде "YYYY-MM-DD HH:MM:SS.mmm",
+     * для пустого момента времени ничего не записывает.
+     * @param first Начало буфера.
+     * @param last Конец буфера.
+     * @param time Момент времени.
+     * @return Указатель на символ после записи или nullptr, если буфера не хватило.
+     */
+    char* formatTime(char* first, char* last, const std::chrono::system_clock::time_point& time);
+
+private:
+    static constexpr std::size_t prefixSize = 19; ///< Длина "YYYY-MM-DD HH:MM:SS".
+    static constexpr std::size_t cacheSize = 4; ///< Количество кэшированных секунд.
+
+    /**
+     * @brief Кэшированный префикс времени одной секунды.
+     */
+    struct Prefix {
+        std::time_t second = -1; ///< Секунда, для которой вычислен префикс.
+        std::array<char, prefixSize> text{}; ///< Префикс "YYYY-MM-DD HH:MM:SS".
+    };
+
+    /**
+     * @brief Возвращает префикс для секунды, вычисляя его при промахе кэша.
+     * @param second Секунда.
+     * @return Ссылка на префикс.
+     */
+    const Prefix& prefix(std::time_t second);
+
+    std::array<Prefix, cacheSize> cache_; ///< Кэш префиксов, индексируется секундой по модулю размера.
+};
+}
+#endif // PROTEI_COV_CDRFORMATTER_HPP
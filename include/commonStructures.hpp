@@ -1,10 +1,15 @@
 #ifndef PROTEI_COV_COMMONNSTRUCTURE_HPP
 #define PROTEI_COV_COMMONNSTRUCTURE_HPP
+#include <array>
 #include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <thread>
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <string_view>
+#include <utility>
 
 /** @file commonStructures.hpp
  *  @brief Содержит общие структуры и типы данных, а также функции
@@ -34,6 +39,19 @@ enum class CallStatus : int {
     Timeout ///< Вызов не был обслужен.
 };
 
+/**
+ * @enum PriorityClass
+ * @brief Класс приоритета вызова, определяется по префиксу номера звонящего.
+ */
+enum class PriorityClass : std::uint8_t {
+    Normal = 0,   ///< Обычный вызов.
+    Vip = 1,      ///< VIP абонент.
+    Emergency = 2 ///< Экстренный вызов.
+};
+
+/// @brief Количество классов приоритета.
+inline constexpr std::size_t priorityClassCount = 3;
+
 namespace utility {
 /**
  * @brief Преобразует перечисление CallStatus в строковое представление.
@@ -51,6 +69,91 @@ std::string to_string(const CallStatus& status);
 std::string prepareTime(const std::chrono::system_clock::time_point& timeP);
 }
 
+namespace utility {
+/**
+ * @brief Класс CallerNumber – номер звонящего, хранящийся в самом объекте без выделения памяти.
+ * Номер E.164 содержит не больше 15 цифр, поэтому символы номера и его длина занимают
+ * два 64-битных слова, и сравнение номеров сводится к сравнению двух целых чисел.
+ */
+class CallerNumber {
+public:
+    static constexpr std::size_t maxLength = 15; ///< Максимальная длина номера.
+
+    /// @brief Создает пустой номер.
+    CallerNumber() = default;
+
+    /**
+     * @brief Копирует номер во внутренний буфер.
+     * @param number Номер звонящего.
+     * @throws std::length_error Если номер длиннее maxLength.
+     */
+    CallerNumber(std::string_view number);
+
+    /// @copydoc CallerNumber(std::string_view)
+    CallerNumber(const char* number) : CallerNumber(std::string_view{number}) {}
+
+    /// @copydoc CallerNumber(std::string_view)
+    CallerNumber(const std::string& number) : CallerNumber(std::string_view{number}) {}
+
+    /**
+     * @brief Проверяет, помещается ли номер в CallerNumber.
+     * @param number Номер звонящего.
+     * @return true, если номер не пустой и не длиннее maxLength.
+     */
+    static bool valid(std::string_view number) {
+        return !number.empty() && number.size() <= maxLength;
+    }
+
+    /// @brief Возвращает номер в виде строки, действительной, пока жив объект.
+    [[nodiscard]] std::string_view view() const {
+        return {data_.data(), size()};
+    }
+
+    /// @brief Возвращает длину номера.
+    [[nodiscard]] std::size_t size() const {
+        return static_cast<unsigned char>(data_[maxLength]);
+    }
+
+    /// @brief Проверяет, пуст ли номер.
+    [[nodiscard]] bool empty() const {
+        return size() == 0;
+    }
+
+    /// @brief Возвращает хэш номера, перемешанный по всем разрядам.
+    [[nodiscard]] std::size_t hash() const {
+        auto [low, high] = words();
+        auto value = low ^ (high * 0x9E3779B97F4A7C15ull);
+        value ^= value >> 33;
+        value *= 0xFF51AFD7ED558CCDull;
+        value ^= value >> 33;
+        return static_cast<std::size_t>(value);
+    }
+
+    /// @brief Сравнивает номера как два 64-битных слова.
+    friend bool operator==(const CallerNumber& lhs, const CallerNumber& rhs) {
+        return lhs.words() == rhs.words();
+    }
+
+private:
+    /// @brief Возвращает содержимое буфера как два 64-битных слова.
+    [[nodiscard]] std::pair<std::uint64_t, std::uint64_t> words() const {
+        std::uint64_t low, high;
+        std::memcpy(&low, data_.data(), sizeof(low));
+        std::memcpy(&high, data_.data() + sizeof(low), sizeof(high));
+        return {low, high};
+    }
+
+    alignas(std::uint64_t) std::array<char, maxLength + 1> data_{}; ///< Символы номера, последний байт – длина.
+};
+}
+
+template <>
+struct std::hash<utility::CallerNumber> {
+    std::size_t operator()(const utility::CallerNumber& number) const noexcept {
+        return number.hash();
+    }
+};
+
 /**
  * @struct CDR
  * @brief Структура CDR (Call Detail Record), представляющая запись о вызове.
@@ -61,13 +164,23 @@ struct CDR {
     TP::CallID callID;                    ///< Уникальный идентификатор вызова.
     CallStatus status;                    ///< Статус вызова (ожидание, завершено, отклонено, завис, повторный вызов,
                                           ///< Очередь перегружена).
+    PriorityClass priority = PriorityClass::Normal; ///< Класс приоритета, в котором вызов ждал в очереди.
     std::chrono::system_clock::time_point operatorCallTime;      ///< Время, когда оператор начал обрабатывать вызов.
     std::size_t operatorID;           ///< Идентификатор потока оператора, обработавшего вызов.
     std::chrono::duration<int> callDuration; ///< Продолжительность вызова в секундах.
-    std::string_view number;                     ///< Номер вызова.
+    utility::CallerNumber number;                ///< Номер вызова.
 };
 std::ofstream& operator<<(std::ofstream& out, const CDR& cdr);
 
+namespace utility {
+/**
+ * @brief Дописывает строковое представление CDR (без перевода строки) в конец строки.
+ * @param out Строка, в которую дописывается запись.
+ * @param cdr Запись о вызове.
+ */
+void appendCDR(std::string& out, const CDR& cdr);
+}
+
 /**
  * @struct Result
  * @brief Структура Result представляет результат обработки вызова.
@@ -1,5 +1,8 @@
 #ifndef PROTEI_COV_CONFIG_HPP
 #define PROTEI_COV_CONFIG_HPP
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <filesystem>
 #include <thread>
 #include <chrono>
@@ -41,11 +44,66 @@ public:
      */
     int getSizeOfQueue() override;
 
+    /**
+     * @copydoc IConfig::getKeepAliveTimeout
+     */
+    int getKeepAliveTimeout() override;
+
+    /**
+     * @copydoc IConfig::getMaxRequestsPerConnection
+     */
+    int getMaxRequestsPerConnection() override;
+
+    /**
+     * @copydoc IConfig::getQueueType
+     */
+    int getQueueType() override;
+
+    /**
+     * @copydoc IConfig::getOperatorMode
+     */
+    int getOperatorMode() override;
+
+    /**
+     * @copydoc IConfig::getCdrDurability
+     */
+    int getCdrDurability() override;
+
+    /**
+     * @copydoc IConfig::getCdrFlushInterval
+     */
+    int getCdrFlushInterval() override;
+
+    /**
+     * @copydoc IConfig::getCdrBatchSize
+     */
+    int getCdrBatchSize() override;
+
+    /**
+     * @copydoc IConfig::getNodeID
+     */
+    int getNodeID() override;
+
+    /**
+     * @copydoc IConfig::getLogLevel
+     */
+    int getLogLevel() override;
+
+    /**
+     * @copydoc IConfig::getLogOverflowPolicy
+     */
+    int getLogOverflowPolicy() override;
+
     /**
      * @copydoc IConfig::getPath
      */
     std::filesystem::path getPath() override;
 
+    /**
+     * @copydoc IConfig::getSnapshot
+     */
+    std::shared_ptr<const ConfigSnapshot> getSnapshot() override;
+
     /**
      * @copydoc IConfig::updateConfig
      */
@@ -96,6 +154,56 @@ public:
      */
     void normalizeSizeOfQueue() override;
 
+    /**
+      * @brief Нормализует KeepAliveTimeout и MaxRequestsPerConnection
+     */
+    void normalizeHttpSettings() override;
+
+    /**
+      * @brief Нормализует QueueType
+      */
+    void normalizeQueueType() override;
+
+    /**
+      * @brief Нормализует QueueDiscipline, CodelTarget и CodelInterval
+      */
+    void normalizeQueueDiscipline() override;
+
+    /**
+      * @brief Нормализует PriorityPrefixes, PriorityWeightNormal, PriorityWeightVip и PriorityWeightEmergency
+      */
+    void normalizePriorityClasses() override;
+
+    /**
+      * @brief Нормализует NumberFilter и NumberFilterMode
+      */
+    void normalizeNumberFilter() override;
+
+    /**
+      * @brief Нормализует OperatorMode
+      */
+    void normalizeOperatorMode() override;
+
+    /**
+      * @brief Нормализует CdrDurability, CdrFlushInterval и CdrBatchSize
+      */
+    void normalizeCdrSettings() override;
+
+    /**
+      * @brief Нормализует NodeID
+      */
+    void normalizeNodeID() override;
+
+    /**
+      * @brief Нормализует LogLevel и LogOverflowPolicy
+      */
+    void normalizeLogSettings() override;
+
+    /**
+      * @brief Нормализует DurationDistribution, DurationMean, DurationSigma и DurationSeed
+      */
+    void normalizeDurationSettings() override;
+
 private:
     /**
      * @brief Приводит путь к нормальному виду для корректной обработки.
@@ -107,13 +215,16 @@ private:
     std::shared_ptr<JsonParser> parser; ///< Парсер JSON-файлов для обработки конфигурации.
     std::filesystem::path path_; ///< Путь к файлу конфигурации.
     std::map<std::string, int> data_; ///< Данные конфигурации.
-    std::shared_ptr<IManager> manager; ///< Указатель на объект менеджера для обработки изменений конфигурации.
+    std::weak_ptr<IManager> manager; ///< Менеджер для обработки изменений конфигурации (не владеющий указатель).
     std::shared_ptr<spdlog::logger> logger_; ///< указатель на асинхронный логгер
     bool notToUpdate;///< флаг на случай, если файл конфигурации сломан, отключает обновление из конфига
 };
 
 /**
  * @brief Класс ThreadSafeConfig представляет собой потокобезопасную реализацию интерфейса IConfig.
+ * Изменение данных выполняется под configMutex, после чего публикуется новый неизменяемый снимок
+ * конфигурации (ConfigSnapshot) через std::atomic<std::shared_ptr>. Методы чтения берут значения из снимка
+ * без мьютекса и без поиска в std::map.
  *
  * @copydoc utility::IConfig
  */
@@ -144,11 +255,66 @@ public:
      */
     int getSizeOfQueue() override;
 
+    /**
+     * @copydoc IConfig::getKeepAliveTimeout
+     */
+    int getKeepAliveTimeout() override;
+
+    /**
+     * @copydoc IConfig::getMaxRequestsPerConnection
+     */
+    int getMaxRequestsPerConnection() override;
+
+    /**
+     * @copydoc IConfig::getQueueType
+     */
+    int getQueueType() override;
+
+    /**
+     * @copydoc IConfig::getOperatorMode
+     */
+    int getOperatorMode() override;
+
+    /**
+     * @copydoc IConfig::getCdrDurability
+     */
+    int getCdrDurability() override;
+
+    /**
+     * @copydoc IConfig::getCdrFlushInterval
+     */
+    int getCdrFlushInterval() override;
+
+    /**
+     * @copydoc IConfig::getCdrBatchSize
+     */
+    int getCdrBatchSize() override;
+
+    /**
+     * @copydoc IConfig::getNodeID
+     */
+    int getNodeID() override;
+
+    /**
+     * @copydoc IConfig::getLogLevel
+     */
+    int getLogLevel() override;
+
+    /**
+     * @copydoc IConfig::getLogOverflowPolicy
+     */
+    int getLogOverflowPolicy() override;
+
     /**
      * @copydoc IConfig::getPath
      */
     std::filesystem::path getPath() override;
 
+    /**
+     * @copydoc IConfig::getSnapshot
+     */
+    std::shared_ptr<const ConfigSnapshot> getSnapshot() override;
+
     /**
      * @copydoc IConfig::updateConfig
      */
@@ -189,6 +355,12 @@ public:
      */
     void RunMonitoring();
 
+    /**
+     * @brief Останавливает мониторинг конфигурации и дожидается завершения потока.
+     * Поток просыпается сразу, а не по таймеру, поэтому остановка не задерживает завершение процесса.
+     */
+    void stopMonitoring();
+
     /**
      * @brief Проверяет, выполняется ли мониторинг конфигурации.
      * @return true, если мониторинг выполняется, в противном случае - false.
@@ -215,6 +387,56 @@ public:
      */
     void normalizeSizeOfQueue() override;
 
+    /**
+      * @brief Нормализует KeepAliveTimeout и MaxRequestsPerConnection
+     */
+    void normalizeHttpSettings() override;
+
+    /**
+      * @brief Нормализует QueueType
+      */
+    void normalizeQueueType() override;
+
+    /**
+      * @brief Нормализует QueueDiscipline, CodelTarget и CodelInterval
+      */
+    void normalizeQueueDiscipline() override;
+
+    /**
+      * @brief Нормализует PriorityPrefixes, PriorityWeightNormal, PriorityWeightVip и PriorityWeightEmergency
+      */
+    void normalizePriorityClasses() override;
+
+    /**
+      * @brief Нормализует NumberFilter и NumberFilterMode
+      */
+    void normalizeNumberFilter() override;
+
+    /**
+      * @brief Нормализует OperatorMode
+      */
+    void normalizeOperatorMode() override;
+
+    /**
+      * @brief Нормализует CdrDurability, CdrFlushInterval и CdrBatchSize
+      */
+    void normalizeCdrSettings() override;
+
+    /**
+      * @brief Нормализует NodeID
+      */
+    void normalizeNodeID() override;
+
+    /**
+      * @brief Нормализует LogLevel и LogOverflowPolicy
+      */
+    void normalizeLogSettings() override;
+
+    /**
+      * @brief Нормализует DurationDistribution, DurationMean, DurationSigma и DurationSeed
+      */
+    void normalizeDurationSettings() override;
+
 private:
     /**
      * @brief Приводит путь к нормальному виду для корректной обработки.
@@ -223,15 +445,32 @@ private:
      */
     static std::filesystem::path makeNormalPath(const std::filesystem::path& pathToFile);
 
+    /**
+     * @brief Перечитывает файл конфигурации и уведомляет менеджера.
+     */
+    void reloadFromFile();
+
+    /// Пауза без событий записи, после которой измененный файл перечитывается.
+    static constexpr std::chrono::milliseconds reloadDebounce{50};
+
+    /**
+     * @brief Публикует снимок текущих данных конфигурации. Вызывается под configMutex или в конструкторе.
+     */
+    void publishSnapshot();
+
     std::shared_ptr<JsonParser> parser; ///< Парсер JSON-файлов для обработки конфигурации.
     std::filesystem::path path_; ///< Путь к файлу конфигурации.
     std::map<std::string, int> data_; ///< Данные конфигурации.
+    std::atomic<std::shared_ptr<const ConfigSnapshot>> snapshot_; ///< Последний опубликованный снимок конфигурации.
     std::thread updateThread; ///< Поток для асинхронного обновления конфигурации.
     std::mutex configMutex; ///< Мьютекс для защиты доступа к конфигурации.
-    bool stopThread; ///< Флаг для остановки потока обновления конфигурации.
+    std::mutex monitorMutex_; ///< Мьютекс для ожидания остановки потока мониторинга.
+    std::condition_variable monitorCv_; ///< Будит поток мониторинга при остановке (без inotify).
+    int wakeFd_ = -1; ///< eventfd, который будит поток мониторинга при остановке (с inotify).
+    std::atomic<bool> stopThread; ///< Флаг для остановки потока обновления конфигурации.
     bool updated; ///< Флаг, указывающий на обновление конфигурации.
     std::time_t lastWriteTime; ///< Время последнего изменения файла конфигурации.
-    std::shared_ptr<IManager> manager; ///< Указатель на объект менеджера для обработки изменений конфигурации.
+    std::weak_ptr<IManager> manager; ///< Менеджер для обработки изменений конфигурации (не владеющий указатель).
     std::shared_ptr<spdlog::logger> logger_; ///< указатель на асинхронный логгер
     bool notToUpdate;///< флаг на случай, если файл конфигурации сломан, отключает обновление из конфига
 };
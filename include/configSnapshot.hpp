@@ -0,0 +1,73 @@
+#ifndef PROTEI_COV_CONFIGSNAPSHOT_HPP
+#define PROTEI_COV_CONFIGSNAPSHOT_HPP
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "prefixTrie.hpp"
+
+/**
+ * @file configSnapshot.hpp
+ * @brief Содержит объявление структуры ConfigSnapshot
+ */
+
+namespace utility {
+/**
+ * @struct ConfigSnapshot
+ * @brief Неизменяемый снимок нормализованной конфигурации.
+ * Снимок создается при каждом обновлении конфигурации и публикуется целиком,
+ * поэтому читатели получают согласованный набор значений без блокировок.
+ */
+struct ConfigSnapshot {
+    int rMin = 0; ///< Минимальная длительность разговора.
+    int rMax = 0; ///< Максимальная длительность разговора.
+    int amountOfOperators = 0; ///< Количество операторов.
+    int sizeOfQueue = 0; ///< Размер очереди.
+    int keepAliveTimeout = 0; ///< Время простоя соединения в секундах.
+    int maxRequestsPerConnection = 0; ///< Максимальное количество запросов в одном соединении.
+    int queueType = 0; ///< Тип очереди задач.
+    int queueDiscipline = 0; ///< Управление очередью: 0 – по размеру, 1 – по времени ожидания (CoDel).
+    int codelTarget = 0; ///< Целевое время ожидания CoDel в миллисекундах.
+    int codelInterval = 0; ///< Интервал CoDel в миллисекундах.
+    int operatorMode = 0; ///< Режим работы операторов.
+    int cdrDurability = 0; ///< Гарантия сохранности CDR.
+    int cdrFlushInterval = 0; ///< Интервал записи пакета CDR в миллисекундах.
+    int cdrBatchSize = 0; ///< Размер пакета CDR в байтах.
+    int nodeID = 0; ///< Идентификатор узла для генерации CallID.
+    int logLevel = 0; ///< Уровень логирования spdlog.
+    int logOverflowPolicy = 0; ///< Поведение логгера при переполнении очереди сообщений.
+    int durationDistribution = 0; ///< Распределение длительности разговора.
+    int durationMean = 0; ///< Средняя длительность разговора в секундах, 0 – середина [RMin, RMax].
+    int durationSigma = 0; ///< Параметр формы логнормального распределения в сотых долях.
+    int durationSeed = 0; ///< Начальное значение детерминированной длительности, 0 – случайная длительность.
+    std::map<std::string, int> priorityPrefixes; ///< Префиксы номеров и их классы приоритета.
+    int priorityWeightNormal = 0; ///< Вес обычных вызовов.
+    int priorityWeightVip = 0; ///< Вес VIP вызовов.
+    int priorityWeightEmergency = 0; ///< Вес экстренных вызовов.
+    int numberFilterMode = 0; ///< Фильтр номеров: 0 – черный список, 1 – белый список.
+    /// Упакованное дерево фильтра номеров: 1 – принять вызов, 0 – отклонить, nullptr – фильтр не задан.
+    /// Дерево строится один раз при загрузке конфигурации и заменяется вместе со снимком.
+    std::shared_ptr<const PrefixTrie> numberFilter;
+    std::filesystem::path path; ///< Путь к файлу конфигурации.
+
+    /**
+     * @brief Создает снимок из данных конфигурации, отсутствующие значения равны 0.
+     * Префиксы NumberFilter собираются в упакованное дерево, корень которого задает решение
+     * для номеров без подходящего префикса согласно NumberFilterMode.
+     * @param data Данные конфигурации.
+     * @param path Путь к файлу конфигурации.
+     * @return Снимок конфигурации.
+     */
+    static ConfigSnapshot fromData(const std::map<std::string, int>& data, const std::filesystem::path& path);
+
+    /**
+     * @brief Проверяет, должен ли вызов с номером быть отклонен фильтром номеров.
+     * Поиск идет по упакованному дереву без выделения памяти.
+     * @param number Номер звонящего.
+     * @return true, если самый длинный подходящий префикс или режим фильтра запрещает номер.
+     */
+    [[nodiscard]] bool rejects(std::string_view number) const;
+};
+}
+#endif // PROTEI_COV_CONFIGSNAPSHOT_HPP
@@ -0,0 +1,90 @@
+#ifndef PROTEI_COV_DURATIONGENERATOR_HPP
+#define PROTEI_COV_DURATIONGENERATOR_HPP
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+#include "configSnapshot.hpp"
+
+/**
+ * @file durationGenerator.hpp
+ * @brief Содержит объявление класса DurationGenerator
+ */
+
+namespace TP {
+/**
+ * @enum DurationDistribution
+ * @brief Распределение длительности разговора.
+ */
+enum class DurationDistribution {
+    Uniform = 0,     ///< Равномерное от RMin до RMax.
+    Exponential = 1, ///< Экспоненциальное с заданным средним.
+    LogNormal = 2    ///< Логнормальное с заданным средним и параметром формы.
+};
+
+/**
+ * @brief Класс DurationGenerator – генератор длительности разговора.
+ * По умолчанию случайные числа берутся из xoshiro256** в thread_local состоянии, которое один раз
+ * на поток инициализируется из std::random_device, поэтому вызов не обращается к ядру и не создает
+ * новое состояние генератора. С ненулевым seed генератор детерминирован: i-е значение вычисляется
+ * из seed и номера обращения (splitmix64), поэтому последовательность длительностей повторяется
+ * от запуска к запуску независимо от того, какие потоки ее запрашивают.
+ * Значения любых распределений округляются до секунды и ограничиваются диапазоном [RMin, RMax].
+ */
+class DurationGenerator {
+public:
+    /**
+     * @brief Конструктор класса DurationGenerator.
+     * @param distribution Распределение длительности.
+     * @param rMin Минимальная длительность в секундах.
+     * @param rMax Максимальная длительность в секундах.
+     * @param mean Средняя длительность в секундах, 0 – середина [rMin, rMax].
+     * @param sigma Параметр формы логнормального распределения (стандартное отклонение логарифма).
+     * @param seed Начальное значение детерминированной последовательности, 0 – случайная последовательность.
+     */
+    DurationGenerator(DurationDistribution distribution, int rMin, int rMax, int mean = 0, double sigma = 0.5,
+                      std::uint64_t seed = 0);
+
+    /**
+     * @brief Создает генератор по снимку конфигурации.
+     * @param snapshot Снимок конфигурации.
+     * @return Генератор с параметрами RMin, RMax, DurationDistribution, DurationMean, DurationSigma, DurationSeed.
+     */
+    static std::shared_ptr<const DurationGenerator> fromSnapshot(const utility::ConfigSnapshot& snapshot);
+
+    /**
+     * @brief Выдает следующую длительность разговора.
+     * @return Длительность в секундах из диапазона [rMin, rMax].
+     */
+    std::chrono::seconds next() const;
+
+    /**
+     * @brief Возвращает распределение длительности.
+     * @return Распределение.
+     */
+    [[nodiscard]] DurationDistribution distribution() const;
+
+private:
+    /**
+     * @brief Выдает следующее случайное 64-битное значение.
+     * @return Случайное значение.
+     */
+    std::uint64_t nextBits() const;
+
+    /**
+     * @brief Выдает равномерно распределенное число.
+     * @return Число из [0, 1).
+     */
+    double nextUnit() const;
+
+    DurationDistribution distribution_; ///< Распределение длительности.
+    int rMin_; ///< Минимальная длительность.
+    int rMax_; ///< Максимальная длительность.
+    double mean_; ///< Средняя длительность.
+    double sigma_; ///< Параметр формы логнормального распределения.
+    std::uint64_t seed_; ///< Начальное значение, 0 – thread_local генератор.
+    mutable std::atomic<std::uint64_t> sequence_{0}; ///< Номер обращения в детерминированном режиме.
+};
+}
+#endif // PROTEI_COV_DURATIONGENERATOR_HPP
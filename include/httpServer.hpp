@@ -2,21 +2,132 @@
 #define PROTEI_COV_HTTPSERVER_HPP
 #include <boost/asio.hpp>
 #include <boost/beast.hpp>
+#include <deque>
 #include <iostream>
 #include <spdlog/async.h>
+#include "admissionGate.hpp"
 #include "builder.hpp"
 
 /**
  * @file httpServer.hpp
- * @brief Содержит объявление класса HttpServer
+ * @brief Содержит объявление классов HttpServer и HttpSession
  */
 
 namespace net {
 namespace asio = boost::asio;
 namespace beast = boost::beast;
 using tcp = asio::ip::tcp;
+
+class HttpServer;
+
+/**
+ * @brief Настройки постоянных соединений.
+ */
+struct HttpSettings {
+    std::chrono::seconds idleTimeout; ///< Время простоя соединения до его закрытия.
+    std::size_t maxRequestsPerConnection; ///< Максимальное количество запросов в одном соединении.
+};
+
+/**
+ * @brief Пара запрос-ответ в конвейере соединения.
+ */
+struct HttpExchange {
+    beast::http::request<beast::http::string_body> request; ///< Запрос.
+    beast::http::response<beast::http::string_body> response; ///< Ответ на запрос.
+    bool ready = false; ///< Флаг готовности ответа к отправке.
+    std::chrono::steady_clock::time_point received; ///< Время получения запроса.
+};
+
+/**
+ * @brief Класс HttpSession – асинхронная сессия одного TCP соединения.
+ * Поддерживает постоянные соединения HTTP/1.1 и конвейерную обработку запросов:
+ * следующий запрос читается, пока предыдущие еще обрабатываются, а ответы
+ * отправляются строго в порядке поступления запросов.
+ * Время жизни сессии поддерживается через shared_ptr, который захватывается
+ * обработчиками асинхронных операций.
+ */
+class HttpSession : public std::enable_shared_from_this<HttpSession> {
+public:
+    /**
+     * @brief Конструктор HttpSession.
+     * @param socket Принятый сокет.
+     * @param server Сервер, обрабатывающий запросы сессии.
+     * @param settings Настройки постоянного соединения.
+     */
+    HttpSession(tcp::socket&& socket, HttpServer& server, HttpSettings settings);
+
+    /**
+     * @brief Запускает чтение запроса.
+     */
+    void start();
+
+    /**
+     * @brief Помечает ответ готовым и отправляет готовые ответы из начала конвейера.
+     * Должен вызываться в исполнителе сессии.
+     * @param exchange Пара запрос-ответ, ответ которой готов.
+     */
+    void complete(const std::shared_ptr<HttpExchange>& exchange);
+
+    /**
+     * @brief Возвращает исполнитель (strand) соединения.
+     * @return Исполнитель соединения.
+     */
+    asio::any_io_executor executor();
+
+private:
+    /// @brief Запускает чтение следующего запроса, если это допустимо.
+    void maybeRead();
+
+    /// @brief Асинхронное чтение запроса.
+    void doRead();
+
+    /**
+     * @brief Обработчик завершения чтения запроса.
+     * @param ec Код ошибки.
+     */
+    void onRead(beast::error_code ec, std::size_t);
+
+    /// @brief Асинхронная запись ответа из начала конвейера.
+    void doWrite();
+
+    /**
+     * @brief Обработчик завершения записи ответа.
+     * @param keepAlive Оставить ли соединение открытым после ответа.
+     * @param ec Код ошибки.
+     */
+    void onWrite(bool keepAlive, beast::error_code ec, std::size_t);
+
+    /// @brief Запускает таймер простоя соединения.
+    void armIdleTimer();
+
+    /**
+     * @brief Обработчик истечения таймера простоя.
+     * @param ec Код ошибки.
+     */
+    void onIdleTimeout(beast::error_code ec);
+
+    /// @brief Закрывает соединение.
+    void doClose();
+
+    static constexpr std::size_t pipelineLimit = 16; ///< Максимальное количество запросов в конвейере.
+
+    beast::tcp_stream stream_; ///< Поток соединения.
+    beast::flat_buffer buffer_; ///< Буфер чтения.
+    asio::steady_timer idleTimer_; ///< Таймер простоя соединения.
+    HttpServer& server_; ///< Сервер, обрабатывающий запросы.
+    HttpSettings settings_; ///< Настройки постоянного соединения.
+    std::shared_ptr<HttpExchange> incoming_; ///< Читаемый в данный момент запрос.
+    std::deque<std::shared_ptr<HttpExchange>> pipeline_; ///< Запросы, ожидающие отправки ответа.
+    std::size_t requestsRead_ = 0; ///< Количество прочитанных запросов.
+    bool reading_ = false; ///< Выполняется ли чтение.
+    bool writing_ = false; ///< Выполняется ли запись.
+    bool closing_ = false; ///< Больше не читать запросы, закрыть соединение после отправки ответов.
+};
+
 /**
  * @brief Класс HttpServer для обработки HTTP-запросов.
+ * Соединения принимаются асинхронно и обслуживаются фиксированным числом потоков ввода-вывода,
+ * которые выполняют io_context.
  */
 class HttpServer {
 public:
@@ -24,32 +135,80 @@ public:
      * @brief Конструктор HttpServer.
      * @param port Порт для прослушивания.
      * @param path Путь для обработки запросов.
+     * @param ioThreads Количество потоков ввода-вывода, 0 – по количеству ядер.
      */
-    HttpServer(short unsigned port, std::filesystem::path path);
+    HttpServer(short unsigned port, std::filesystem::path path, unsigned ioThreads);
     /**
-     * @brief Запускает сервер.
+     * @brief Запускает сервер, блокирует вызывающий поток до остановки io_context.
+     * После остановки записывает накопленные CDR.
      */
     void run();
 
+    /**
+     * @brief Останавливает сервер.
+     */
+    void stop();
+
 private:
+    friend class HttpSession;
+
+    /// @brief Асинхронное ожидание нового соединения.
+    void doAccept();
+
     /**
-     * @brief Обрабатывает HTTP-запросы.
-     * @param socket Сокет для обработки запроса.
+     * @brief Обработчик принятого соединения.
+     * @param ec Код ошибки.
+     * @param socket Принятый сокет.
      */
-    void handleHttpRequest(tcp::socket socket);
+    void onAccept(beast::error_code ec, tcp::socket socket);
+
     /**
-     * @brief Обрабатывает HTTP-запрос по указанному пути.
+     * @brief Обрабатывает HTTP-запрос по указанному пути, по готовности ответа вызывает
+     * HttpSession::complete.
      * @param path Путь запроса.
-     * @param res Ответ на запрос.
+     * @param session Сессия, которой принадлежит запрос.
+     * @param exchange Пара запрос-ответ.
      */
-    void handleRequest(const std::string& path, beast::http::response<beast::http::string_body>& res);
+    void handleRequest(std::string_view path,
+                       const std::shared_ptr<HttpSession>& session,
+                       const std::shared_ptr<HttpExchange>& exchange);
 
     /**
-     * @brief Обрабатывает телефонный вызов.
-     * @param res Ответ на запрос.
+     * @brief Обрабатывает телефонный вызов без блокировки потока ввода-вывода,
+     * результат вызова доставляется в исполнитель сессии обработчиком завершения.
+     * Номер копируется в задачу, номер пустой или длиннее CallerNumber::maxLength отклоняется с кодом 400.
+     * Если вызовов в работе уже SizeOfQueue + AmountOfOperators, вызов отклоняется со статусом Overloaded
+     * до создания задачи, без мьютекса пула потоков и очереди.
+     * @param session Сессия, которой принадлежит запрос.
+     * @param exchange Пара запрос-ответ.
      * @param phone Номер телефона.
      */
-    void processPhoneCall(beast::http::response<beast::http::string_body>& res, std::string_view phone);
+    void processPhoneCall(const std::shared_ptr<HttpSession>& session,
+                          const std::shared_ptr<HttpExchange>& exchange,
+                          std::string_view phone);
+
+    /**
+     * @brief Отклоняет вызов со статусом Overloaded без создания задачи и записывает его CDR.
+     * @param session Сессия, которой принадлежит запрос.
+     * @param exchange Пара запрос-ответ.
+     * @param phone Номер телефона.
+     */
+    void rejectOverloaded(const std::shared_ptr<HttpSession>& session,
+                          const std::shared_ptr<HttpExchange>& exchange,
+                          std::string_view phone);
+
+    /**
+     * @brief Возвращает настройки постоянных соединений из конфигурации.
+     * @return Настройки постоянных соединений.
+     */
+    HttpSettings httpSettings();
+
+    /**
+     * @brief Заполняет ответ на основе результата вызова.
+     * @param res Ответ на запрос.
+     * @param result Результат вызова.
+     */
+    void fillCallResponse(beast::http::response<beast::http::string_body>& res, const Result& result);
 
     /**
      * @brief Обрабатывает статус вызова, доп функция для HttpServer@processPhoneCall
@@ -58,16 +217,35 @@ private:
      */
     void workWithCallStatus(beast::http::response<beast::http::string_body>& res, CallStatus status);
 
+    /**
+     * @brief Выдает метрики в текстовом формате Prometheus.
+     * @param res Ответ на запрос.
+     */
+    void processMetrics(beast::http::response<beast::http::string_body>& res);
+
     /**
      * @brief Обрабатывает запрос на обновление.
      * @param res Ответ на запрос.
      */
     void processUpdate(beast::http::response<beast::http::string_body>& res);
 
+    /**
+     * @brief Дополняет ответ общими заголовками.
+     * @param res Ответ на запрос.
+     */
+    static void finalizeResponse(beast::http::response<beast::http::string_body>& res);
+
 private:
     asio::io_context io_context; ///< Контекст ввода-вывода для асинхронных операций.
     tcp::acceptor acceptor; ///< Акцептор для прослушивания входящих соединений.
+    asio::signal_set signals; ///< Сигналы завершения работы (SIGINT, SIGTERM).
+    unsigned ioThreads_; ///< Количество потоков ввода-вывода.
     std::shared_ptr<Manager> manager; ///< Указатель на объект Manager для обработки вызовов.
+    std::shared_ptr<utility::ThreadSafeConfig> config_; ///< Указатель на объект конфигурации.
+    std::vector<std::shared_ptr<IRecorder>> recorders_; ///< Писатели CDR, сбрасываются при остановке сервера.
+    std::shared_ptr<utility::CallMetrics> metrics_; ///< Метрики вызовов и HTTP запросов.
+    std::shared_ptr<TP::CallIdGenerator> callIdGenerator_; ///< Генератор CallID, общий с пулом потоков.
+    TP::AdmissionGate admission_; ///< Счетчик вызовов в работе для ранней проверки перегрузки.
     std::shared_ptr<spdlog::logger> logger_; ///< Указатель на объект логгера.
 };
 }
@@ -1,12 +1,16 @@
 #ifndef PROTEI_COV_INTERFACES_HPP
 #define PROTEI_COV_INTERFACES_HPP
+#include <exception>
 #include <filesystem>
+#include <functional>
 #include <future>
 #include <memory>
 #include <queue>
 #include <spdlog/logger.h>
 
 #include "commonStructures.hpp"
+#include "configSnapshot.hpp"
+#include "durationGenerator.hpp"
 #include "jsonParser.hpp"
 #include "recorder.hpp"
 
@@ -52,12 +56,79 @@ public:
      */
     virtual int getSizeOfQueue() = 0;
 
+    /**
+     * @brief Возвращает время простоя постоянного HTTP соединения из конфигурации.
+     * @return Время простоя в секундах.
+     */
+    virtual int getKeepAliveTimeout() = 0;
+
+    /**
+     * @brief Возвращает максимальное количество запросов в одном HTTP соединении из конфигурации.
+     * @return Максимальное количество запросов.
+     */
+    virtual int getMaxRequestsPerConnection() = 0;
+
+    /**
+     * @brief Возвращает тип очереди задач из конфигурации.
+     * @return 0 – очередь с мьютексом пула потоков, 1 – очередь без блокировок,
+     * 2 – локальные очереди операторов с перехватом задач.
+     */
+    virtual int getQueueType() = 0;
+
+    /**
+     * @brief Возвращает режим работы операторов из конфигурации.
+     * @return 0 – оператор занимает поток, 1 – операторы освобождает колесо таймеров.
+     */
+    virtual int getOperatorMode() = 0;
+
+    /**
+     * @brief Возвращает гарантию сохранности CDR из конфигурации.
+     * @return 0 – запись пакетами, 1 – запись пакетами с fdatasync, 2 – запись только по размеру пакета.
+     */
+    virtual int getCdrDurability() = 0;
+
+    /**
+     * @brief Возвращает интервал записи пакета CDR из конфигурации.
+     * @return Интервал в миллисекундах.
+     */
+    virtual int getCdrFlushInterval() = 0;
+
+    /**
+     * @brief Возвращает размер пакета CDR из конфигурации.
+     * @return Размер пакета в байтах.
+     */
+    virtual int getCdrBatchSize() = 0;
+
+    /**
+     * @brief Возвращает идентификатор узла для генерации CallID из конфигурации.
+     * @return Идентификатор узла от 0 до 1023.
+     */
+    virtual int getNodeID() = 0;
+
+    /**
+     * @brief Возвращает уровень логирования из конфигурации.
+     * @return Уровень spdlog от 0 (trace) до 6 (off).
+     */
+    virtual int getLogLevel() = 0;
+
+    /**
+     * @brief Возвращает поведение логгера при переполнении очереди сообщений из конфигурации.
+     * @return 0 - ожидать освобождения места, 1 - вытеснять самые старые сообщения.
+     */
+    virtual int getLogOverflowPolicy() = 0;
+
     /**
      * @brief Возвращает путь к файлу конфигурации.
      * @return Путь к файлу конфигурации.
      */
     virtual std::filesystem::path getPath() = 0;
 
+    /**
+     * @brief Возвращает снимок текущей конфигурации.
+     * @return Указатель на неизменяемый снимок, который остается корректным после обновления конфигурации.
+     */
+    virtual std::shared_ptr<const ConfigSnapshot> getSnapshot() = 0;
+
     /**
      * @brief Обновляет данные конфигурации.
      */
@@ -110,12 +181,68 @@ public:
       * @brief Нормализует SizeOfQueue
      */
      virtual void normalizeSizeOfQueue() = 0;
+
+     /**
+      * @brief Нормализует KeepAliveTimeout и MaxRequestsPerConnection
+      */
+     virtual void normalizeHttpSettings() = 0;
+
+     /**
+      * @brief Нормализует QueueType
+      */
+     virtual void normalizeQueueType() = 0;
+
+     /**
+      * @brief Нормализует QueueDiscipline, CodelTarget и CodelInterval
+      */
+     virtual void normalizeQueueDiscipline() = 0;
+
+     /**
+      * @brief Нормализует PriorityPrefixes, PriorityWeightNormal, PriorityWeightVip и PriorityWeightEmergency
+      */
+     virtual void normalizePriorityClasses() = 0;
+
+     /**
+      * @brief Нормализует NumberFilter и NumberFilterMode
+      */
+     virtual void normalizeNumberFilter() = 0;
+
+     /**
+      * @brief Нормализует OperatorMode
+      */
+     virtual void normalizeOperatorMode() = 0;
+
+     /**
+      * @brief Нормализует CdrDurability, CdrFlushInterval и CdrBatchSize
+      */
+     virtual void normalizeCdrSettings() = 0;
+
+     /**
+      * @brief Нормализует NodeID
+      */
+     virtual void normalizeNodeID() = 0;
+
+     /**
+      * @brief Нормализует LogLevel и LogOverflowPolicy
+      */
+     virtual void normalizeLogSettings() = 0;
+
+     /**
+      * @brief Нормализует DurationDistribution, DurationMean, DurationSigma и DurationSeed
+      */
+     virtual void normalizeDurationSettings() = 0;
 };
 
 }
 
 
 namespace TP {
+/**
+ * @brief Обработчик завершения вызова. Первым аргументом передается исключение,
+ * если обработка вызова завершилась с ошибкой, иначе nullptr.
+ */
+using CompletionHandler = std::function<void(std::exception_ptr, Result)>;
+
 class ITask {
 public:
     /**
@@ -132,6 +259,18 @@ public:
     /// @brief Обработка вызова.
     virtual Result doTask() = 0;
 
+    /**
+     * @brief Начинает обработку вызова оператором, не дожидаясь окончания разговора.
+     * @return Время, на которое вызов занимает оператора.
+     */
+    virtual std::chrono::seconds beginCall() = 0;
+
+    /**
+     * @brief Завершает вызов, начатый beginCall.
+     * @return Результат вызова.
+     */
+    virtual Result finishCall() = 0;
+
     /**
      * @brief Установка ID вызова.
      * @param id ID вызова.
@@ -150,13 +289,45 @@ public:
      */
     virtual void addPromise(std::shared_ptr<std::promise<Result>> promise) = 0;
 
+    /**
+     * @brief Функция добавления обработчика завершения в задачу
+     * @param handler обработчик, вызываемый по завершении задачи
+     */
+    virtual void addCompletionHandler(CompletionHandler handler) = 0;
+
+    /**
+     * @brief Установка генератора длительности разговора.
+     * @param generator генератор длительности, nullptr - равномерная длительность от RMin до RMax
+     */
+    virtual void setDurationGenerator(std::shared_ptr<const DurationGenerator> generator) = 0;
+
+    /**
+     * @brief Завершает задачу: устанавливает значение промиса и вызывает обработчик завершения.
+     * @param result Результат вызова.
+     */
+    virtual void complete(const Result& result) = 0;
+
+    /**
+     * @brief Завершает задачу с ошибкой: устанавливает исключение промиса и вызывает обработчик завершения.
+     * @param exception Исключение, возникшее при обработке вызова.
+     */
+    virtual void fail(std::exception_ptr exception) = 0;
+
     /**
      * @brief Функция получения номер звонящего
-     * @return возвращает number_
+     * @return возвращает номер звонящего, которым владеет задача
+     */
+    virtual const utility::CallerNumber& getNumber() = 0;
+
+    /**
+     * @brief Срок ожидания вызова: после него вызов не обслуживается и завершается по таймауту.
+     * @return Время поступления вызова плюс RMax.
      */
-    virtual std::string_view getNumber() = 0;
+    [[nodiscard]] virtual std::chrono::system_clock::time_point getDeadline() const = 0;
 
-    std::shared_ptr<std::promise<Result>> promise_;///< Промис с результатом.
+    std::shared_ptr<std::promise<Result>> promise_;///< Промис с результатом, nullptr - результат получает только обработчик завершения.
+
+    CompletionHandler onComplete_;///< Обработчик завершения вызова.
 
     CDR cdr;///< CDR звонка
 
@@ -203,6 +374,29 @@ public:
      */
     virtual void pop() = 0;
 
+    /**
+     * @brief Извлекает задачу из начала очереди, если она есть.
+     * @param taskPair Пара, в которую будет перемещена задача и ее уникальный идентификатор вызова.
+     * @return true, если задача извлечена, false, если очередь пуста.
+     */
+    virtual bool tryPop(std::pair<std::shared_ptr<ITask>, CallID>& taskPair) = 0;
+
+    /**
+     * @brief Извлекает задачу для указанного оператора, если она есть.
+     * Очереди, разделенные по операторам, начинают поиск с очереди оператора,
+     * остальные очереди игнорируют номер оператора.
+     * @param taskPair Пара, в которую будет перемещена задача и ее уникальный идентификатор вызова.
+     * @param worker Номер оператора.
+     * @return true, если задача извлечена, false, если очередь пуста.
+     */
+    virtual bool tryPop(std::pair<std::shared_ptr<ITask>, CallID>& taskPair, std::size_t worker) = 0;
+
+    /**
+     * @brief Проверяет, допускает ли очередь добавление и извлечение задач без внешней синхронизации.
+     * @return true, если очередь потокобезопасна и не требует мьютекса пула потоков.
+     */
+    [[nodiscard]] virtual bool isLockFree() const = 0;
+
     /**
      * @brief Обновляет максимальный размер очереди.
      * @param size Новый размер очереди.
@@ -227,6 +421,19 @@ public:
      */
     virtual void writeCDR(const CDR& cdr) = 0;
 
+    /**
+     * @brief Завершает со статусом Timeout вызовы, срок ожидания которых истек, не дожидаясь оператора.
+     * @param now Текущее время.
+     * @return Количество завершенных вызовов.
+     */
+    virtual std::size_t expire(std::chrono::system_clock::time_point now) = 0;
+
+    /**
+     * @brief Возвращает ближайший срок ожидания вызова в очереди.
+     * @return Срок ожидания или time_point::max(), если очередь не отслеживает сроки или пуста.
+     */
+    [[nodiscard]] virtual std::chrono::system_clock::time_point nextDeadline() const = 0;
+
 };
 
 /**
@@ -252,6 +459,22 @@ public:
      */
     virtual std::pair<CallID, std::future<Result>> add_task(std::shared_ptr<ITask> task) = 0;
 
+    /**
+     * @brief Добавляет задачу в пул потоков без ожидания результата.
+     * @param task Задача для выполнения в потоке.
+     * @param handler Обработчик, который будет вызван по завершении задачи.
+     * @return Уникальный идентификатор вызова.
+     */
+    virtual CallID add_task(std::shared_ptr<ITask> task, CompletionHandler handler) = 0;
+
+    /**
+     * @brief Завершает вызов без постановки в очередь: назначает CallID, пишет CDR и передает результат задаче.
+     * @param task Задача, промис или обработчик завершения которой уже установлен.
+     * @param status Статус, с которым завершается вызов.
+     * @return Уникальный идентификатор вызова.
+     */
+    virtual CallID reject(std::shared_ptr<ITask> task, CallStatus status) = 0;
+
     /**
      * @brief Останавливает выполнение задач в пуле потоков.
      */
@@ -268,6 +491,13 @@ public:
      */
     virtual void transferObjects(const std::shared_ptr<IThreadPool>& oldThreadPool) = 0;
 
+    /**
+     * @brief Изменяет количество операторов без остановки пула и передачи очереди.
+     * Новые операторы запускаются сразу, лишние завершаются после окончания текущего вызова.
+     * @param amountOfOperators Новое количество операторов.
+     */
+    virtual void resize(unsigned amountOfOperators) = 0;
+
 
     /**
      * @brief Установка новой очереди задачи
@@ -315,6 +545,14 @@ public:
      */
     virtual std::pair<TP::CallID, std::future<Result>> addTask(std::string_view number) = 0;
 
+    /**
+     * @brief Добавляет задачу в тредпул без ожидания результата.
+     * @param number Номер телефона, должен жить до вызова обработчика.
+     * @param handler Обработчик, который будет вызван по завершении задачи.
+     * @return Уникальный идентификатор задачи.
+     */
+    virtual TP::CallID addTask(std::string_view number, TP::CompletionHandler handler) = 0;
+
     /**
      * @brief Запускает выполнение задач в тредпуле.
      */
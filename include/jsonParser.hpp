@@ -45,6 +45,7 @@ public:
 
     /**
      * @brief Метод для вывода конфигурационных данных в виде карты (map) строк и целых чисел.
+     * Значения вложенных объектов попадают в карту под ключами вида "Объект.ключ".
      *  @return Карта, содержащая конфигурационные данные.
      */
     std::map<std::string, int> outputConfig();
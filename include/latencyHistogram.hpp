@@ -0,0 +1,92 @@
+#ifndef PROTEI_COV_LATENCYHISTOGRAM_HPP
+#define PROTEI_COV_LATENCYHISTOGRAM_HPP
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file latencyHistogram.hpp
+ * @brief Содержит объявление класса LatencyHistogram
+ */
+
+namespace utility {
+/**
+ * @brief Класс LatencyHistogram – гистограмма задержек в духе HDR Histogram.
+ * Значения в микросекундах раскладываются по логарифмически-линейным корзинам: каждый интервал
+ * [2^k, 2^(k+1)) делится на 16 равных корзин, поэтому относительная погрешность не превышает 1/16
+ * во всем диапазоне от микросекунды до десятков часов.
+ * Запись не использует блокировок: у каждого потока своя копия счетчиков (шард), выбранная по номеру
+ * потока, а при чтении шарды складываются.
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned subBucketBits = 4; ///< Разрядность номера корзины внутри степени двойки.
+    static constexpr std::size_t subBucketCount = std::size_t{1} << subBucketBits; ///< Корзин на степень двойки.
+    static constexpr unsigned maxShift = 34; ///< Наибольший сдвиг, значения от 2^39 мкс попадают в последнюю корзину.
+    static constexpr std::size_t bucketCount = subBucketCount * (maxShift + 2); ///< Общее число корзин.
+    static constexpr std::size_t shardCount = 16; ///< Количество копий счетчиков для записывающих потоков.
+
+    /**
+     * @brief Сводные данные гистограммы на момент чтения.
+     */
+    struct Snapshot {
+        std::array<std::uint64_t, bucketCount> counts{}; ///< Количество значений в каждой корзине.
+        std::uint64_t count = 0; ///< Общее количество значений.
+        std::uint64_t sum = 0; ///< Сумма значений в микросекундах.
+
+        /**
+         * @brief Возвращает значение, не меньше которого p процентов записанных значений.
+         * @param p Перцентиль от 0 до 100.
+         * @return Верхняя граница корзины, в которую попал перцентиль, либо 0 для пустой гистограммы.
+         */
+        [[nodiscard]] std::chrono::microseconds percentile(double p) const;
+
+        /**
+         * @brief Считает значения, не превышающие границу.
+         * @param micros Граница в микросекундах.
+         * @return Количество значений в корзинах, верхняя граница которых не больше micros.
+         */
+        [[nodiscard]] std::uint64_t countAtMost(std::uint64_t micros) const;
+    };
+
+    /**
+     * @brief Записывает значение. Отрицательные значения считаются нулевыми.
+     * @param value Задержка.
+     */
+    void record(std::chrono::microseconds value);
+
+    /**
+     * @brief Складывает шарды всех потоков.
+     * @return Сводные данные гистограммы.
+     */
+    [[nodiscard]] Snapshot snapshot() const;
+
+    /**
+     * @brief Возвращает номер корзины для значения.
+     * @param micros Значение в микросекундах.
+     * @return Номер корзины.
+     */
+    static std::size_t bucketIndex(std::uint64_t micros);
+
+    /**
+     * @brief Возвращает наибольшее значение, попадающее в корзину.
+     * @param index Номер корзины.
+     * @return Верхняя граница корзины в микросекундах включительно.
+     */
+    static std::uint64_t bucketUpperBound(std::size_t index);
+
+private:
+    /**
+     * @brief Копия счетчиков одной группы потоков, выровненная по кэш-линии.
+     */
+    struct alignas(64) Shard {
+        std::array<std::atomic<std::uint64_t>, bucketCount> counts{}; ///< Счетчики корзин.
+        std::atomic<std::uint64_t> sum{0}; ///< Сумма значений в микросекундах.
+    };
+
+    std::array<Shard, shardCount> shards_; ///< Шарды счетчиков.
+};
+}
+#endif // PROTEI_COV_LATENCYHISTOGRAM_HPP
@@ -0,0 +1,181 @@
+#ifndef PROTEI_COV_LOCKFREEQUEUE_HPP
+#define PROTEI_COV_LOCKFREEQUEUE_HPP
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "commonStructures.hpp"
+#include "interfaces.hpp"
+#include "recorder.hpp"
+
+/**
+ * @file lockFreeQueue.hpp
+ * @brief Содержит объявление класса LockFreeQueue, который реализует интерфейс IQueue
+ * без общего мьютекса пула потоков.
+ */
+
+namespace TP {
+/**
+ * @brief Класс LockFreeQueue – ограниченная очередь MPMC на основе кольцевого буфера
+ * с порядковыми номерами слотов (схема Вьюкова).
+ * Добавление и извлечение задач не требуют task_queue_mutex, поэтому пул потоков
+ * работает с такой очередью без общего мьютекса и условной переменной.
+ * Поиск дубликатов выполняется по индексу номер -> задача, разделенному на сегменты
+ * со своими мьютексами. Замененная задача остается в буфере и пропускается при извлечении.
+ * Методы front() и back() не поддерживаются, для извлечения используется tryPop().
+ *
+ * @copydoc IQueue
+ */
+class LockFreeQueue : public IQueue {
+public:
+    /**
+     * @brief Конструктор класса LockFreeQueue.
+     * @param size Максимальный размер очереди.
+     */
+    explicit LockFreeQueue(int size);
+
+    /**
+     * @brief Не поддерживается, бросает std::logic_error.
+     */
+    std::pair<std::shared_ptr<ITask>, CallID>& back() override;
+
+    /**
+     * @brief Не поддерживается, бросает std::logic_error.
+     */
+    std::pair<std::shared_ptr<ITask>, CallID>& front() override;
+
+    /**
+     * @copydoc IQueue::empty
+     */
+    [[nodiscard]] bool empty() const override;
+
+    /**
+     * @copydoc IQueue::push
+     */
+    [[nodiscard]] bool push(std::pair<std::shared_ptr<ITask>, CallID>&& taskPair) override;
+
+    /**
+     * @brief Удаляет задачу из начала очереди.
+     *
+     * @copydoc IQueue::pop
+     */
+    void pop() override;
+
+    /**
+     * @copydoc IQueue::tryPop
+     */
+    bool tryPop(std::pair<std::shared_ptr<ITask>, CallID>& taskPair) override;
+
+    /**
+     * @brief Очередь общая для всех операторов, номер оператора игнорируется.
+     *
+     * @copydoc IQueue::tryPop(std::pair<std::shared_ptr<ITask>, CallID>&, std::size_t)
+     */
+    bool tryPop(std::pair<std::shared_ptr<ITask>, CallID>& taskPair, std::size_t worker) override;
+
+    /**
+     * @copydoc IQueue::isLockFree
+     */
+    [[nodiscard]] bool isLockFree() const override;
+
+    /**
+     * @brief Обновляет максимальный размер очереди, размер ограничен емкостью буфера.
+     * @param size Новый максимальный размер очереди.
+     *
+     * @copydoc IQueue::update
+     */
+    void update(int size) override;
+
+    /**
+     * @copydoc IQueue::setLogger
+     */
+    void setLogger(std::shared_ptr<spdlog::logger> logger) override;
+
+    /**
+     * @copydoc IQueue::setRecorders
+     */
+    void setRecorders(std::vector<std::shared_ptr<IRecorder>> recorders) override;
+
+    /**
+     * @copydoc IQueue::writeCDR
+     */
+    void writeCDR(const CDR& cdr) override;
+
+    /**
+     * @brief Сроки ожидания не отслеживаются, просроченный вызов завершает оператор.
+     * @return 0.
+     */
+    std::size_t expire(std::chrono::system_clock::time_point now) override;
+
+    /**
+     * @brief Сроки ожидания не отслеживаются.
+     * @return time_point::max().
+     */
+    [[nodiscard]] std::chrono::system_clock::time_point nextDeadline() const override;
+
+private:
+    /**
+     * @brief Слот кольцевого буфера.
+     */
+    struct Cell {
+        std::atomic<std::size_t> sequence; ///< Порядковый номер слота.
+        std::pair<std::shared_ptr<ITask>, CallID> data; ///< Задача и ее идентификатор вызова.
+    };
+
+    /**
+     * @brief Сегмент индекса номер звонящего -> задача в очереди.
+     */
+    struct Shard {
+        std::mutex mutex; ///< Мьютекс сегмента.
+        std::unordered_map<utility::CallerNumber, std::shared_ptr<ITask>> tasks; ///< Задачи в очереди по номеру.
+    };
+
+    /**
+     * @brief Помещает задачу в кольцевой буфер.
+     * @param taskPair Пара, содержащая задачу и ее уникальный идентификатор вызова.
+     * @return false, если буфер заполнен.
+     */
+    bool enqueue(std::pair<std::shared_ptr<ITask>, CallID>& taskPair);
+
+    /**
+     * @brief Извлекает задачу из кольцевого буфера.
+     * @param taskPair Пара, в которую будет перемещена задача.
+     * @return false, если буфер пуст.
+     */
+    bool dequeue(std::pair<std::shared_ptr<ITask>, CallID>& taskPair);
+
+    /**
+     * @brief Возвращает сегмент индекса для номера звонящего.
+     * @param number Номер звонящего.
+     * @return Ссылка на сегмент.
+     */
+    Shard& shardFor(const utility::CallerNumber& number);
+
+    /**
+     * @brief Завершает задачу, вызов которой не был поставлен в очередь.
+     * @param task Задача.
+     * @param callID Идентификатор вызова.
+     * @param status Статус вызова (CallStatus::Duplication или CallStatus::Overloaded).
+     */
+    void reject(const std::shared_ptr<ITask>& task, CallID callID, CallStatus status);
+
+    static constexpr std::size_t cacheLine = 64; ///< Размер кэш-линии.
+    static constexpr std::size_t shardCount = 64; ///< Количество сегментов индекса.
+
+    std::unique_ptr<Cell[]> buffer_; ///< Кольцевой буфер.
+    std::size_t mask_; ///< Маска позиции в кольцевом буфере.
+    alignas(cacheLine) std::atomic<std::size_t> enqueuePos_{0}; ///< Позиция записи.
+    alignas(cacheLine) std::atomic<std::size_t> dequeuePos_{0}; ///< Позиция чтения.
+    alignas(cacheLine) std::atomic<std::size_t> size_{0}; ///< Количество задач в очереди.
+    std::atomic<std::size_t> sizeOfQueue; ///< Максимальный размер очереди.
+    std::array<Shard, shardCount> shards_; ///< Сегменты индекса номер -> задача.
+    std::shared_ptr<spdlog::logger> logger_; ///< Указатель на асинхронный логгер.
+    std::vector<std::shared_ptr<IRecorder>> recorders_; ///< Вектор писателей CDR.
+    std::mutex cdrMutex_; ///< Мьютекс для записи CDR при помощи писателей
+};
+}
+#endif // PROTEI_COV_LOCKFREEQUEUE_HPP
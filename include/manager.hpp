@@ -1,6 +1,8 @@
 #ifndef PROTEI_COV_MANAGER_HPP
 #define PROTEI_COV_MANAGER_HPP
 #include "interfaces.hpp"
+#include "taskPool.hpp"
+#include <atomic>
 #include <shared_mutex>
 /**
  * @file manager.hpp
@@ -25,6 +27,8 @@ public:
 
     /**
      * @brief Добавление задачи в тредпул.
+     * Вызов с номером, запрещенным фильтром номеров, завершается со статусом CallStatus::Rejected
+     * без постановки в очередь.
      * @param number Номер вызова.
      * @return Пара, содержащая уникальный идентификатор вызова и будущий результат выполнения задачи.
      *
@@ -32,6 +36,18 @@ public:
      */
     std::pair<TP::CallID, std::future<Result>> addTask(std::string_view number) override;
 
+    /**
+     * @brief Добавление задачи в тредпул без ожидания результата.
+     * Вызов с номером, запрещенным фильтром номеров, завершается со статусом CallStatus::Rejected
+     * без постановки в очередь, обработчик вызывается до возврата из метода.
+     * @param number Номер вызова, должен жить до вызова обработчика.
+     * @param handler Обработчик, который будет вызван по завершении задачи.
+     * @return Уникальный идентификатор вызова.
+     *
+     * @copydoc IManager::addTask(std::string_view, TP::CompletionHandler)
+     */
+    TP::CallID addTask(std::string_view number, TP::CompletionHandler handler) override;
+
     /**
      * @brief Запуск тредпула.
      *
@@ -85,15 +101,34 @@ public:
     bool processRequestForUpdate() override;
 
 private:
+    /**
+     * @brief Создает задачу для вызова.
+     * @param number Номер вызова.
+     * @param snapshot Снимок конфигурации, по которому создается задача.
+     * @return Указатель на задачу.
+     */
+    std::shared_ptr<TP::ITask> makeTask(std::string_view number, const utility::ConfigSnapshot& snapshot);
+
+    /**
+     * @brief Отвечает на вызов, запрещенный фильтром номеров, без постановки в очередь.
+     * @param task Задача с установленным промисом или обработчиком завершения.
+     * @return Уникальный идентификатор вызова.
+     */
+    TP::CallID rejectTask(std::shared_ptr<TP::ITask> task);
+
     std::shared_mutex updateMtx; ///< Мьютекс для обеспечения безопасного доступа к обновлению.
 
-    int RMin_; ///< Верхняя граница.
+    /// Снимок конфигурации, из которого создаются задачи, читается без updateMtx.
+    /// Вместе со снимком атомарно заменяется и дерево фильтра номеров.
+    std::atomic<std::shared_ptr<const utility::ConfigSnapshot>> snapshot_;
 
-    int RMax_;  ///< Нижняя граница.
+    /// Генератор длительности разговора по снимку конфигурации, общий для всех задач до следующего обновления.
+    std::atomic<std::shared_ptr<const TP::DurationGenerator>> durationGenerator_;
 
     std::shared_ptr<utility::IConfig> config_; ///< Указатель на объект конфигурации.
     std::shared_ptr<TP::IThreadPool> threadPool_; ///< Указатель на объект тредпула.
     std::shared_ptr<spdlog::logger> logger_; ///< указатель на асинхронный логгер.
+    TP::TaskPool taskPool_; ///< Пул памяти задач.
 };
 
 
@@ -0,0 +1,96 @@
+#ifndef PROTEI_COV_PREFIXTRIE_HPP
+#define PROTEI_COV_PREFIXTRIE_HPP
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file prefixTrie.hpp
+ * @brief Содержит объявление класса PrefixTrie
+ */
+
+namespace utility {
+/**
+ * @brief Класс PrefixTrie – цифровое дерево префиксов номеров.
+ * Узлы хранятся в одном непрерывном массиве и ссылаются на потомков по индексу,
+ * поэтому поиск идет по цифрам номера без выделения памяти и без обращений к куче
+ * за пределами массива узлов. Поиск возвращает значение самого длинного префикса номера,
+ * для которого задано значение, за время, ограниченное длиной номера.
+ * После заполнения дерево можно упаковать методом compact: узлы раскладываются по уровням,
+ * потомки узла лежат подряд, а вместо десяти индексов хранится битовая маска цифр,
+ * поэтому списки из сотен тысяч префиксов занимают в несколько раз меньше памяти,
+ * а верхние уровни дерева остаются в кеше процессора.
+ */
+class PrefixTrie {
+public:
+    static constexpr int none = -1; ///< Значение узла, для которого правило не задано.
+
+    /// @brief Создает дерево с одним корневым узлом.
+    PrefixTrie();
+
+    /**
+     * @brief Добавляет префикс или заменяет его значение.
+     * @param prefix Префикс из цифр, пустой префикс задает значение для всех номеров.
+     * @param value Значение префикса, не меньше 0.
+     * @throws std::invalid_argument если префикс содержит не только цифры или значение отрицательное.
+     * @throws std::logic_error если дерево уже упаковано.
+     */
+    void insert(std::string_view prefix, int value);
+
+    /**
+     * @brief Упаковывает дерево для поиска, после упаковки добавлять префиксы нельзя.
+     */
+    void compact();
+
+    /**
+     * @brief Ищет самый длинный префикс номера, для которого задано значение.
+     * Поиск прекращается на первом символе, который не является цифрой.
+     * @param number Номер.
+     * @return Значение префикса или none, если ни один префикс не подходит.
+     */
+    [[nodiscard]] int match(std::string_view number) const;
+
+    /**
+     * @brief Возвращает количество заданных префиксов.
+     * @return Количество префиксов.
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @brief Проверяет, задан ли хотя бы один префикс.
+     * @return true, если префиксов нет.
+     */
+    [[nodiscard]] bool empty() const;
+
+private:
+    /**
+     * @brief Ищет самый длинный префикс номера в упакованном дереве.
+     * @param number Номер.
+     * @return Значение префикса или none, если ни один префикс не подходит.
+     */
+    [[nodiscard]] int matchPacked(std::string_view number) const;
+
+    /**
+     * @brief Узел дерева.
+     */
+    struct Node {
+        std::array<std::uint32_t, 10> children{}; ///< Индексы потомков по цифре, 0 – потомка нет.
+        int value = none; ///< Значение префикса, который заканчивается в узле.
+    };
+
+    /**
+     * @brief Узел упакованного дерева.
+     */
+    struct PackedNode {
+        std::uint32_t first = 0; ///< Индекс первого потомка, остальные потомки лежат следом по возрастанию цифры.
+        std::uint16_t mask = 0; ///< Бит i установлен, если у узла есть потомок по цифре i.
+        int value = none; ///< Значение префикса, который заканчивается в узле.
+    };
+
+    std::vector<Node> nodes_; ///< Узлы дерева до упаковки, корень – nodes_[0].
+    std::vector<PackedNode> packed_; ///< Узлы упакованного дерева в порядке обхода в ширину, корень – packed_[0].
+    std::size_t size_ = 0; ///< Количество заданных префиксов.
+};
+}
+#endif // PROTEI_COV_PREFIXTRIE_HPP
@@ -0,0 +1,201 @@
+#ifndef PROTEI_COV_PRIORITYQUEUE_HPP
+#define PROTEI_COV_PRIORITYQUEUE_HPP
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "commonStructures.hpp"
+#include "interfaces.hpp"
+#include "prefixTrie.hpp"
+#include "queue.hpp"
+#include "recorder.hpp"
+
+/**
+ * @file priorityQueue.hpp
+ * @brief Содержит объявление класса PriorityQueue, который реализует интерфейс IQueue.
+ */
+
+namespace TP {
+/**
+ * @brief Класс PriorityQueue – очередь вызовов с классами приоритета.
+ * Для каждого класса (PriorityClass) заведена своя очередь Queue, класс вызова выбирается при
+ * постановке по самому длинному подходящему префиксу номера в PrefixTrie за время, ограниченное
+ * длиной номера. Повторный вызов всегда попадает в тот же класс, поэтому поиск дубликатов,
+ * сроки ожидания и CoDel работают внутри очереди класса.
+ * Операторы получают вызовы по алгоритму deficit round robin: классы обходятся от экстренного
+ * к обычному, за один проход класс отдает не больше своего веса вызовов, поэтому экстренные
+ * и VIP вызовы обслуживаются раньше, а обычные не простаивают бесконечно.
+ * SizeOfQueue ограничивает суммарное количество вызовов во всех классах.
+ *
+ * @copydoc IQueue
+ */
+class PriorityQueue : public IQueue {
+public:
+    /**
+     * @brief Конструктор класса PriorityQueue.
+     * @param size Максимальное суммарное количество вызовов в очереди.
+     * @param rules Префиксы номеров и их классы приоритета, nullptr – все вызовы обычные.
+     * @param weights Веса классов: сколько вызовов класс отдает за один проход, не меньше 1.
+     */
+    PriorityQueue(int size, std::shared_ptr<const utility::PrefixTrie> rules,
+                  std::array<unsigned, priorityClassCount> weights);
+
+    /**
+     * @brief Возвращает ссылку на последний добавленный вызов.
+     * @return Ссылка на пару, содержащую задачу и ее уникальный идентификатор вызова.
+     *
+     * @copydoc IQueue::back
+     */
+    std::pair<std::shared_ptr<ITask>, CallID>& back() override;
+
+    /**
+     * @brief Возвращает ссылку на вызов, который будет выдан оператору следующим.
+     * @return Ссылка на пару, содержащую задачу и ее уникальный идентификатор вызова.
+     *
+     * @copydoc IQueue::front
+     */
+    std::pair<std::shared_ptr<ITask>, CallID>& front() override;
+
+    /**
+     * @copydoc IQueue::empty
+     */
+    [[nodiscard]] bool empty() const override;
+
+    /**
+     * @brief Добавляет вызов в очередь его класса приоритета.
+     * @param taskPair Пара, содержащая задачу и ее уникальный идентификатор вызова.
+     * @return true, если задача успешно добавлена, false, если очередь переполнена.
+     *
+     * @copydoc IQueue::push
+     */
+    [[nodiscard]] bool push(std::pair<std::shared_ptr<ITask>, CallID>&& taskPair) override;
+
+    /**
+     * @brief Удаляет вызов, который вернул front.
+     *
+     * @copydoc IQueue::pop
+     */
+    void pop() override;
+
+    /**
+     * @copydoc IQueue::tryPop
+     */
+    bool tryPop(std::pair<std::shared_ptr<ITask>, CallID>& taskPair) override;
+
+    /**
+     * @brief Очередь общая для всех операторов, номер оператора игнорируется.
+     *
+     * @copydoc IQueue::tryPop(std::pair<std::shared_ptr<ITask>, CallID>&, std::size_t)
+     */
+    bool tryPop(std::pair<std::shared_ptr<ITask>, CallID>& taskPair, std::size_t worker) override;
+
+    /**
+     * @brief Очередь требует внешней синхронизации через мьютекс пула потоков.
+     * @return false.
+     */
+    [[nodiscard]] bool isLockFree() const override;
+
+    /**
+     * @brief Обновляет максимальное суммарное количество вызовов в очереди.
+     * @param size Новый максимальный размер очереди.
+     *
+     * @copydoc IQueue::update
+     */
+    void update(int size) override;
+
+    /**
+     * @copydoc IQueue::setLogger
+     */
+    void setLogger(std::shared_ptr<spdlog::logger> logger) override;
+
+    /**
+     * @copydoc IQueue::setRecorders
+     */
+    void setRecorders(std::vector<std::shared_ptr<IRecorder>> recorders) override;
+
+    /**
+     * @copydoc IQueue::writeCDR
+     */
+    void writeCDR(const CDR& cdr) override;
+
+    /**
+     * @copydoc IQueue::expire
+     */
+    std::size_t expire(std::chrono::system_clock::time_point now) override;
+
+    /**
+     * @copydoc IQueue::nextDeadline
+     */
+    [[nodiscard]] std::chrono::system_clock::time_point nextDeadline() const override;
+
+    /**
+     * @brief Включает CoDel в очереди каждого класса.
+     * @param target Целевое время ожидания в очереди.
+     * @param interval Время, в течение которого ожидание должно превышать target до первого отбрасывания.
+     */
+    void setCodel(std::chrono::milliseconds target, std::chrono::milliseconds interval);
+
+    /**
+     * @brief Определяет класс приоритета номера.
+     * @param number Номер звонящего.
+     * @return Класс самого длинного подходящего префикса, PriorityClass::Normal, если префикса нет.
+     */
+    [[nodiscard]] PriorityClass classify(const utility::CallerNumber& number) const;
+
+    /**
+     * @brief Возвращает количество вызовов в очереди класса.
+     * Значение обновляется при каждом изменении очереди и может читаться без мьютекса пула потоков.
+     * @param priority Класс приоритета.
+     * @return Количество вызовов в очереди класса.
+     */
+    [[nodiscard]] std::size_t depth(PriorityClass priority) const;
+
+private:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1); ///< Нет непустого класса.
+
+    /**
+     * @brief Выбирает класс, который обслуживается следующим, и при начале его хода начисляет вес.
+     * @return Номер класса или npos, если все очереди пусты.
+     */
+    std::size_t nextClass();
+
+    /**
+     * @brief Списывает выданный вызов с остатка хода класса и передает ход, если остаток исчерпан.
+     * @param index Номер класса.
+     */
+    void charge(std::size_t index);
+
+    /**
+     * @brief Передает ход следующему по приоритету классу.
+     */
+    void advance();
+
+    /**
+     * @brief Обновляет счетчик глубины очереди класса.
+     * @param index Номер класса.
+     */
+    void refreshDepth(std::size_t index);
+
+    /**
+     * @brief Обрабатывает вызов, когда очередь переполнена.
+     * @param taskPair Пара, содержащая указатель на задачу и идентификатор вызова.
+     */
+    void handleOverloadedTask(const std::pair<std::shared_ptr<ITask>, CallID>& taskPair);
+
+    std::array<std::unique_ptr<Queue>, priorityClassCount> classes_; ///< Очереди классов приоритета.
+    std::array<unsigned, priorityClassCount> weights_; ///< Веса классов.
+    std::array<unsigned, priorityClassCount> deficit_{}; ///< Остаток хода класса.
+    std::array<std::atomic<std::size_t>, priorityClassCount> depth_{}; ///< Количество вызовов в очереди класса.
+    std::size_t current_ = priorityClassCount - 1; ///< Класс, у которого сейчас ход.
+    std::size_t last_ = 0; ///< Класс последнего добавленного вызова.
+    std::size_t sizeOfQueue_; ///< Максимальное суммарное количество вызовов.
+    std::shared_ptr<const utility::PrefixTrie> rules_; ///< Префиксы номеров и их классы.
+    std::shared_ptr<spdlog::logger> logger_; ///< Указатель на асинхронный логгер.
+    std::vector<std::shared_ptr<IRecorder>> recorders_; ///< Вектор писателей CDR.
+    std::mutex cdrMutex_; ///< Мьютекс для записи CDR при помощи писателей.
+};
+}
+#endif // PROTEI_COV_PRIORITYQUEUE_HPP
@@ -1,8 +1,11 @@
 #ifndef PROTEI_COV_QUEUE_HPP
 #define PROTEI_COV_QUEUE_HPP
+#include <chrono>
 #include <memory>
 #include <queue>
+#include <string_view>
 #include <tuple>
+#include <vector>
 
 #include "commonStructures.hpp"
 #include "interfaces.hpp"
@@ -16,6 +19,20 @@
 namespace TP {
 /**
  * @brief Класс Queue представляет собой реализацию интерфейса IQueue.
+ * Задачи хранятся в кольцевом буфере фиксированной емкости, а поиск задачи
+ * по номеру звонящего выполняется через хэш-индекс с открытой адресацией,
+ * поэтому добавление, извлечение и замена дубликата выполняются за O(1).
+ * Удаленные дубликаты остаются в буфере пустыми слотами и вычищаются при
+ * извлечении из начала очереди или при уплотнении буфера.
+ * В режиме CoDel очередь запоминает время постановки каждой задачи и при извлечении
+ * отбрасывает вызовы со статусом Overloaded, если время ожидания в очереди дольше interval
+ * не опускается ниже target. Пока задержка остается высокой, отбрасывания учащаются
+ * (интервал между ними уменьшается как interval / sqrt(count)), поэтому глубина очереди
+ * подстраивается под целевую задержку, а SizeOfQueue остается только верхней границей.
+ * Сроки ожидания вызовов (время поступления плюс RMax) хранятся в двоичной куче с обратным
+ * индексом слот -> позиция в куче, поэтому ближайший срок доступен за O(1), а вызов удаляется
+ * из кучи за O(log n) при извлечении, замене дубликата или истечении срока. Просроченные вызовы
+ * завершаются со статусом Timeout в expire и никогда не выдаются оператору.
  *
  * @copydoc IQueue
  */
@@ -51,6 +68,12 @@ public:
      */
     [[nodiscard]] bool empty() const override;
 
+    /**
+     * @brief Возвращает количество задач в очереди.
+     * @return Количество задач без учета пустых слотов.
+     */
+    [[nodiscard]] std::size_t size() const;
+
     /**
      * @brief Добавляет задачу в конец очереди.
      * @param taskPair Пара, содержащая задачу и ее уникальный идентификатор вызова.
@@ -67,6 +90,24 @@ public:
      */
     void pop() override;
 
+    /**
+     * @copydoc IQueue::tryPop
+     */
+    bool tryPop(std::pair<std::shared_ptr<ITask>, CallID>& taskPair) override;
+
+    /**
+     * @brief Очередь общая для всех операторов, номер оператора игнорируется.
+     *
+     * @copydoc IQueue::tryPop(std::pair<std::shared_ptr<ITask>, CallID>&, std::size_t)
+     */
+    bool tryPop(std::pair<std::shared_ptr<ITask>, CallID>& taskPair, std::size_t worker) override;
+
+    /**
+     * @brief Очередь требует внешней синхронизации через мьютекс пула потоков.
+     * @return false.
+     */
+    [[nodiscard]] bool isLockFree() const override;
+
     /**
      * @brief Обновляет максимальный размер очереди.
      * @param size Новый максимальный размер очереди.
@@ -89,7 +130,54 @@ public:
 
     void writeCDR(const CDR& cdr) override;
 
+    /**
+     * @brief Включает управление очередью по времени ожидания (CoDel).
+     * @param target Целевое время ожидания в очереди.
+     * @param interval Время, в течение которого ожидание должно превышать target до первого отбрасывания.
+     */
+    void setCodel(std::chrono::milliseconds target, std::chrono::milliseconds interval);
+
+    /**
+     * @copydoc IQueue::expire
+     */
+    std::size_t expire(std::chrono::system_clock::time_point now) override;
+
+    /**
+     * @copydoc IQueue::nextDeadline
+     */
+    [[nodiscard]] std::chrono::system_clock::time_point nextDeadline() const override;
+
 private:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Извлекает задачу из начала очереди и проверяет время ее ожидания по правилам CoDel.
+     * Вызывается только для непустой очереди.
+     * @param taskPair Пара, в которую будет перемещена задача и ее уникальный идентификатор вызова.
+     * @param now Текущее время.
+     * @return true, если ожидание превышает target дольше interval и задачу можно отбросить.
+     */
+    bool dequeueHead(std::pair<std::shared_ptr<ITask>, CallID>& taskPair, Clock::time_point now);
+
+    /**
+     * @brief Отбрасывает задачу, ожидавшую в очереди слишком долго, со статусом Overloaded.
+     * @param taskPair Пара, содержащая указатель на задачу и идентификатор вызова.
+     */
+    void shedTask(const std::pair<std::shared_ptr<ITask>, CallID>& taskPair);
+
+    /**
+     * @brief Завершает вызов, срок ожидания которого истек, со статусом Timeout.
+     * @param taskPair Пара, содержащая указатель на задачу и идентификатор вызова.
+     */
+    void expireTask(const std::pair<std::shared_ptr<ITask>, CallID>& taskPair);
+
+    /**
+     * @brief Время следующего отбрасывания по закону управления CoDel.
+     * @param from Время, от которого отсчитывается интервал.
+     * @return from + interval / sqrt(count).
+     */
+    [[nodiscard]] Clock::time_point controlLaw(Clock::time_point from) const;
+
     /**
      * @brief Обрабатывает задачу, когда очередь перегружена.
      * @param taskPair Пара, содержащая указатель на задачу и идентификатор вызова.
@@ -105,17 +193,122 @@ private:
     /**
      * @brief Дополняет CDR и отправляет его на запись
      * @param task Ссылка на задачу для которой будет обрабатываться cdr
-     * @param isDuplication тип статуса, если true,
-     * значит в CDR будет записано CallStatus::Duplication, иначе будет
-     * записано CallStatus::Overloaded
+     * @param status статус, с которым вызов покидает очередь без оператора:
+     * CallStatus::Duplication, CallStatus::Overloaded или CallStatus::Timeout
+     */
+    void processCDR(std::shared_ptr<ITask> task, CallStatus status);
+
+    /**
+     * @brief Ищет в индексе слот с задачей звонящего.
+     * @param number Номер звонящего.
+     * @param hash Хэш номера звонящего.
+     * @return Позиция в индексе или npos, если задачи нет.
+     */
+    std::size_t findIndex(const utility::CallerNumber& number, std::size_t hash) const;
+
+    /**
+     * @brief Ищет в индексе запись, указывающую на позицию кольцевого буфера.
+     * @param position Позиция в кольцевом буфере.
+     * @return Позиция в индексе или npos, если записи нет.
+     */
+    std::size_t findIndex(std::size_t position) const;
+
+    /**
+     * @brief Добавляет в индекс позицию задачи в кольцевом буфере.
+     * @param position Позиция задачи в кольцевом буфере.
+     * @param hash Хэш номера звонящего.
+     */
+    void insertIndex(std::size_t position, std::size_t hash);
+
+    /**
+     * @brief Удаляет запись из индекса сдвигом следующих записей цепочки.
+     * @param hole Позиция в индексе.
      */
-    void processCDR(std::shared_ptr<ITask> task, bool isDuplication);
+    void eraseIndex(std::size_t hole);
 
-    std::vector<std::pair<std::shared_ptr<ITask>, CallID>> queue_; ///< Вектор для хранения задач в очереди.
+    /**
+     * @brief Добавляет срок ожидания задачи в кучу.
+     * @param position Позиция задачи в кольцевом буфере.
+     * @param deadline Срок ожидания.
+     */
+    void insertDeadline(std::size_t position, std::chrono::system_clock::time_point deadline);
+
+    /**
+     * @brief Удаляет срок ожидания задачи из кучи.
+     * @param position Позиция задачи в кольцевом буфере.
+     */
+    void eraseDeadline(std::size_t position);
+
+    /**
+     * @brief Поднимает элемент кучи к вершине, пока его срок раньше срока родителя.
+     * @param i Позиция в куче.
+     */
+    void siftUp(std::size_t i);
+
+    /**
+     * @brief Опускает элемент кучи, пока срок одного из потомков раньше его срока.
+     * @param i Позиция в куче.
+     */
+    void siftDown(std::size_t i);
+
+    /**
+     * @brief Пропускает пустые слоты в начале и в конце кольцевого буфера.
+     */
+    void trim();
+
+    /**
+     * @brief Уплотняет кольцевой буфер, удаляя пустые слоты, и перестраивает индекс.
+     * @param capacity Новая емкость буфера.
+     */
+    void rebuild(std::size_t capacity);
+
+    /**
+     * @brief Возвращает слот кольцевого буфера по позиции.
+     * @param position Позиция в кольцевом буфере.
+     * @return Ссылка на слот.
+     */
+    std::pair<std::shared_ptr<ITask>, CallID>& slot(std::size_t position);
+
+    /**
+     * @brief Запись хэш-индекса номер звонящего -> позиция в кольцевом буфере.
+     */
+    struct IndexEntry {
+        std::size_t position; ///< Позиция задачи в кольцевом буфере.
+        std::size_t hash; ///< Хэш номера звонящего.
+    };
+
+    /**
+     * @brief Элемент кучи сроков ожидания.
+     */
+    struct DeadlineEntry {
+        std::chrono::system_clock::time_point deadline; ///< Срок ожидания.
+        std::size_t position; ///< Позиция задачи в кольцевом буфере.
+    };
+
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1); ///< Пустая запись индекса.
+
+    std::vector<std::pair<std::shared_ptr<ITask>, CallID>> ring_; ///< Кольцевой буфер задач в очереди.
+    std::vector<std::size_t> hashes_; ///< Хэши номеров звонящих для каждого слота кольцевого буфера.
+    std::vector<Clock::time_point> enqueued_; ///< Время постановки в очередь для каждого слота кольцевого буфера.
+    std::vector<IndexEntry> index_; ///< Хэш-индекс с открытой адресацией.
+    std::vector<DeadlineEntry> deadlines_; ///< Двоичная куча сроков ожидания, ближайший срок в начале.
+    std::vector<std::size_t> heapPositions_; ///< Позиция в куче сроков для каждого слота кольцевого буфера.
+    std::size_t head_ = 0; ///< Позиция начала очереди.
+    std::size_t tail_ = 0; ///< Позиция после конца очереди.
+    std::size_t size_ = 0; ///< Количество задач в очереди.
     std::size_t sizeOfQueue; ///< Максимальный размер очереди.
     std::shared_ptr<spdlog::logger> logger_; ///< Указатель на асинхронный логгер.
     std::vector<std::shared_ptr<IRecorder>> recorders_;///< Вектор писателей CDR.
     std::mutex cdrMutex_; ///< Мьютекс для записи CDR при помощи писателей
+
+    bool codel_ = false; ///< Включено ли управление очередью по времени ожидания.
+    Clock::duration target_{}; ///< Целевое время ожидания CoDel.
+    Clock::duration interval_{}; ///< Интервал CoDel.
+    Clock::time_point firstAboveTime_{}; ///< Момент, после которого ожидание выше target разрешает отбрасывание.
+    Clock::time_point dropNext_{}; ///< Время следующего отбрасывания в режиме отбрасывания.
+    std::size_t dropCount_ = 0; ///< Количество отбрасываний в текущем режиме отбрасывания.
+    std::size_t lastCount_ = 0; ///< Значение dropCount_ при входе в предыдущий режим отбрасывания.
+    bool dropping_ = false; ///< Находится ли очередь в режиме отбрасывания.
 };
 }
 #endif // PROTEI_COV_QUEUE_HPP
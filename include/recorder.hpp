@@ -2,14 +2,18 @@
 #define PROTEI_COV_RECORDER_HPP
 #include "commonStructures.hpp"
 
+#include <condition_variable>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <spdlog/spdlog.h>
 
 /**
  * @file recorder.hpp
  * @brief Содержит объявления интерфейса IRecorder,
- * и его реализации FileRecorder.
+ * и его реализаций FileRecorder и AsyncFileRecorder.
  */
 
 /**
@@ -24,6 +28,11 @@ public:
      */
     virtual void makeRecord(const CDR& cdr) = 0;
 
+    /**
+     * @brief Дожидается записи в файл всех ранее созданных записей.
+     */
+    virtual void flush() = 0;
+
     virtual void setLogger(std::shared_ptr<spdlog::logger> logger) = 0;
 
     /// @brief Виртуальный деструктор интерфейса.
@@ -46,6 +55,10 @@ public:
      */
     void makeRecord(const CDR& cdr) override;
 
+    /**
+     * @copydoc IRecorder::flush
+     */
+    void flush() override;
 
     void setLogger(std::shared_ptr<spdlog::logger> logger) override;
 
@@ -54,5 +67,86 @@ private:
     std::ofstream file;
 };
 
+/**
+ * @enum CdrDurability
+ * @brief Гарантия сохранности CDR, которую дает AsyncFileRecorder.
+ */
+enum class CdrDurability : int {
+    Flush = 0, ///< Пакет записывается в файл по размеру или по интервалу.
+    Fdatasync = 1, ///< Пакет записывается в файл и сбрасывается на диск через fdatasync.
+    None = 2 ///< Записи копятся в памяти и записываются в файл только по размеру пакета.
+};
+
+/**
+ * @class AsyncFileRecorder
+ * @brief Класс-наследник интерфейса IRecorder, асинхронно записывающий CDR в файл пакетами.
+ * makeRecord только копирует запись в общий буфер, а отдельный поток-писатель забирает
+ * накопленные записи, форматирует их и записывает одним системным вызовом, когда набирается
+ * пакет заданного размера или истекает интервал сброса. При разрушении все записи
+ * гарантированно попадают в файл.
+ */
+class AsyncFileRecorder : public IRecorder {
+public:
+    /**
+     * @brief Конструктор AsyncFileRecorder.
+     * @param path Путь к файлу CDR.
+     * @param durability Гарантия сохранности записей.
+     * @param batchSize Размер пакета в байтах, по достижении которого пакет записывается в файл.
+     * @param flushInterval Интервал, по истечении которого накопленные записи записываются в файл.
+     */
+    AsyncFileRecorder(const std::filesystem::path& path,
+                      CdrDurability durability = CdrDurability::Flush,
+                      std::size_t batchSize = 64 * 1024,
+                      std::chrono::milliseconds flushInterval = std::chrono::milliseconds{50});
+
+    /**
+     * @brief Деструктор, записывает в файл все оставшиеся записи.
+     */
+    ~AsyncFileRecorder() override;
+
+    /**
+     * @brief Помещает копию записи в буфер писателя.
+     * @param cdr Структура CDR с данными о вызове.
+     */
+    void makeRecord(const CDR& cdr) override;
+
+    /**
+     * @copydoc IRecorder::flush
+     */
+    void flush() override;
+
+    void setLogger(std::shared_ptr<spdlog::logger> logger) override;
+
+private:
+    /// @brief Цикл потока-писателя.
+    void run();
+
+    /**
+     * @brief Записывает отформатированный пакет в файл.
+     * @param sync Сбросить ли файл на диск через fdatasync.
+     */
+    void writeOut(bool sync);
+
+    static constexpr std::size_t recordSizeEstimate = 128; ///< Оценка размера одной отформатированной записи.
+
+    int fd_; ///< Дескриптор файла CDR.
+    CdrDurability durability_; ///< Гарантия сохранности записей.
+    std::size_t batchSize_; ///< Размер пакета в байтах.
+    std::chrono::milliseconds flushInterval_; ///< Интервал сброса пакета.
+
+    std::mutex bufferMutex_; ///< Мьютекс буфера записей.
+    std::condition_variable writerAccess_; ///< Условная переменная пробуждения писателя.
+    std::condition_variable flushed_; ///< Условная переменная завершения записи пакета.
+    std::vector<CDR> pending_; ///< Записи, ожидающие форматирования.
+    std::size_t pendingBytes_ = 0; ///< Оценка размера ожидающих записей.
+    unsigned long long enqueued_ = 0; ///< Количество принятых записей.
+    unsigned long long written_ = 0; ///< Количество записей, записанных в файл.
+    bool flushRequested_ = false; ///< Запрошена запись всех накопленных записей.
+    bool stop_ = false; ///< Флаг остановки писателя.
+
+    std::string batch_; ///< Отформатированный пакет, принадлежит потоку-писателю.
+    std::thread writer_; ///< Поток-писатель.
+};
+
 
 #endif
\ No newline at end of file
@@ -0,0 +1,193 @@
+#ifndef PROTEI_COV_SHARDEDQUEUE_HPP
+#define PROTEI_COV_SHARDEDQUEUE_HPP
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "commonStructures.hpp"
+#include "interfaces.hpp"
+#include "recorder.hpp"
+
+/**
+ * @file shardedQueue.hpp
+ * @brief Содержит объявление класса ShardedQueue, который реализует интерфейс IQueue
+ * с отдельной очередью для каждого оператора.
+ */
+
+namespace TP {
+/**
+ * @brief Класс ShardedQueue – очередь, разделенная на локальные очереди операторов.
+ * Задача попадает в локальную очередь по хэшу номера звонящего, поэтому все вызовы
+ * с одним номером оказываются в одной локальной очереди и проверка дубликатов остается локальной.
+ * Оператор извлекает задачу из своей очереди или из очереди соседа, если у соседа задача ждет дольше,
+ * что приблизительно сохраняет общий порядок FIFO. Если своя очередь пуста, оператор забирает задачу
+ * из любой другой очереди. Каждая локальная очередь защищена своим мьютексом, внешняя синхронизация
+ * через мьютекс пула не нужна. Замененные дубликаты остаются в локальной очереди
+ * и пропускаются при извлечении.
+ * Методы front() и back() не поддерживаются, для извлечения используется tryPop().
+ *
+ * @copydoc IQueue
+ */
+class ShardedQueue : public IQueue {
+public:
+    /**
+     * @brief Конструктор класса ShardedQueue.
+     * @param size Максимальный размер очереди (суммарно по всем локальным очередям).
+     * @param shards Количество локальных очередей, обычно по числу рабочих потоков пула.
+     */
+    ShardedQueue(int size, std::size_t shards);
+
+    /**
+     * @brief Не поддерживается, бросает std::logic_error.
+     */
+    std::pair<std::shared_ptr<ITask>, CallID>& back() override;
+
+    /**
+     * @brief Не поддерживается, бросает std::logic_error.
+     */
+    std::pair<std::shared_ptr<ITask>, CallID>& front() override;
+
+    /**
+     * @copydoc IQueue::empty
+     */
+    [[nodiscard]] bool empty() const override;
+
+    /**
+     * @copydoc IQueue::push
+     */
+    [[nodiscard]] bool push(std::pair<std::shared_ptr<ITask>, CallID>&& taskPair) override;
+
+    /**
+     * @brief Удаляет задачу так же, как tryPop для оператора с номером 0.
+     *
+     * @copydoc IQueue::pop
+     */
+    void pop() override;
+
+    /**
+     * @brief Извлекает задачу для оператора с номером 0.
+     *
+     * @copydoc IQueue::tryPop
+     */
+    bool tryPop(std::pair<std::shared_ptr<ITask>, CallID>& taskPair) override;
+
+    /**
+     * @copydoc IQueue::tryPop(std::pair<std::shared_ptr<ITask>, CallID>&, std::size_t)
+     */
+    bool tryPop(std::pair<std::shared_ptr<ITask>, CallID>& taskPair, std::size_t worker) override;
+
+    /**
+     * @brief Очередь синхронизирована мьютексами локальных очередей.
+     * @return true.
+     */
+    [[nodiscard]] bool isLockFree() const override;
+
+    /**
+     * @copydoc IQueue::update
+     */
+    void update(int size) override;
+
+    /**
+     * @copydoc IQueue::setLogger
+     */
+    void setLogger(std::shared_ptr<spdlog::logger> logger) override;
+
+    /**
+     * @copydoc IQueue::setRecorders
+     */
+    void setRecorders(std::vector<std::shared_ptr<IRecorder>> recorders) override;
+
+    /**
+     * @copydoc IQueue::writeCDR
+     */
+    void writeCDR(const CDR& cdr) override;
+
+    /**
+     * @brief Сроки ожидания не отслеживаются, просроченный вызов завершает оператор.
+     * @return 0.
+     */
+    std::size_t expire(std::chrono::system_clock::time_point now) override;
+
+    /**
+     * @brief Сроки ожидания не отслеживаются.
+     * @return time_point::max().
+     */
+    [[nodiscard]] std::chrono::system_clock::time_point nextDeadline() const override;
+
+    /**
+     * @brief Возвращает количество локальных очередей.
+     * @return Количество локальных очередей.
+     */
+    [[nodiscard]] std::size_t shardCount() const;
+
+private:
+    /**
+     * @brief Задача в локальной очереди.
+     */
+    struct Entry {
+        std::pair<std::shared_ptr<ITask>, CallID> taskPair; ///< Задача и ее идентификатор вызова.
+        std::uint64_t sequence; ///< Порядковый номер добавления в очередь.
+    };
+
+    /**
+     * @brief Локальная очередь оператора.
+     */
+    struct Shard {
+        std::mutex mutex; ///< Мьютекс локальной очереди.
+        std::deque<Entry> tasks; ///< Задачи в порядке добавления.
+        std::unordered_map<utility::CallerNumber, std::shared_ptr<ITask>> index; ///< Задачи в очереди по номеру.
+    };
+
+    static constexpr std::uint64_t none = UINT64_MAX; ///< Порядковый номер пустой локальной очереди.
+
+    /**
+     * @brief Возвращает локальную очередь для номера звонящего.
+     * @param number Номер звонящего.
+     * @return Ссылка на локальную очередь.
+     */
+    Shard& shardFor(const utility::CallerNumber& number);
+
+    /**
+     * @brief Удаляет из начала локальной очереди замененные дубликаты. Вызывается под мьютексом очереди.
+     * @param shard Локальная очередь.
+     */
+    static void skipReplaced(Shard& shard);
+
+    /**
+     * @brief Возвращает порядковый номер задачи в начале локальной очереди.
+     * @param shard Номер локальной очереди.
+     * @return Порядковый номер или none, если очередь пуста.
+     */
+    std::uint64_t headSequence(std::size_t shard);
+
+    /**
+     * @brief Извлекает задачу из начала локальной очереди.
+     * @param shard Номер локальной очереди.
+     * @param taskPair Пара, в которую будет перемещена задача.
+     * @return false, если локальная очередь пуста.
+     */
+    bool popFrom(std::size_t shard, std::pair<std::shared_ptr<ITask>, CallID>& taskPair);
+
+    /**
+     * @brief Завершает задачу, вызов которой не был поставлен в очередь.
+     * @param task Задача.
+     * @param callID Идентификатор вызова.
+     * @param status Статус вызова (CallStatus::Duplication или CallStatus::Overloaded).
+     */
+    void reject(const std::shared_ptr<ITask>& task, CallID callID, CallStatus status);
+
+    std::vector<std::unique_ptr<Shard>> shards_; ///< Локальные очереди операторов.
+    std::atomic<std::uint64_t> sequence_{0}; ///< Счетчик порядковых номеров задач.
+    std::atomic<std::size_t> size_{0}; ///< Количество задач в очереди.
+    std::atomic<std::size_t> sizeOfQueue; ///< Максимальный размер очереди.
+    std::shared_ptr<spdlog::logger> logger_; ///< Указатель на асинхронный логгер.
+    std::vector<std::shared_ptr<IRecorder>> recorders_; ///< Вектор писателей CDR.
+    std::mutex cdrMutex_; ///< Мьютекс для записи CDR при помощи писателей
+};
+}
+#endif // PROTEI_COV_SHARDEDQUEUE_HPP
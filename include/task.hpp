@@ -29,9 +29,38 @@ public:
          const std::chrono::system_clock::time_point& startTime,
          std::shared_ptr<spdlog::logger> logger);
 
+    /**
+     * @brief Конструктор с заданным промисом.
+     * @param RMin нижняя граница времени
+     * @param RMax верхняя граница времени
+     * @param number номер звонящего
+     * @param startTime время создания задачи
+     * @param logger логгер
+     * @param promise промис с результатом, nullptr - результат получает только обработчик завершения
+     * @throws std::length_error если номер длиннее utility::CallerNumber::maxLength
+     */
+    Task(int RMin,
+         int RMax,
+         std::string_view number,
+         const std::chrono::system_clock::time_point& startTime,
+         std::shared_ptr<spdlog::logger> logger,
+         std::shared_ptr<std::promise<Result>> promise);
+
     /// @brief Обработка вызова.
     Result doTask();
 
+    /**
+     * @brief Начинает обработку вызова оператором, не дожидаясь окончания разговора.
+     * @return Время, на которое вызов занимает оператора.
+     */
+    std::chrono::seconds beginCall();
+
+    /**
+     * @brief Завершает вызов, начатый beginCall.
+     * @return Результат вызова.
+     */
+    Result finishCall();
+
     /**
      * @brief Установка ID вызова.
      * @param id ID вызова.
@@ -50,11 +79,41 @@ public:
      */
     void addPromise(std::shared_ptr<std::promise<Result>> promise);
 
+    /**
+     * @brief Функция добавления обработчика завершения в задачу
+     * @param handler обработчик, вызываемый по завершении задачи
+     */
+    void addCompletionHandler(CompletionHandler handler);
+
+    /**
+     * @brief Установка генератора длительности разговора.
+     * @param generator генератор длительности, nullptr - равномерная длительность от RMin до RMax
+     */
+    void setDurationGenerator(std::shared_ptr<const DurationGenerator> generator);
+
+    /**
+     * @brief Завершает задачу: устанавливает значение промиса и вызывает обработчик завершения.
+     * @param result Результат вызова.
+     */
+    void complete(const Result& result);
+
+    /**
+     * @brief Завершает задачу с ошибкой: устанавливает исключение промиса и вызывает обработчик завершения.
+     * @param exception Исключение, возникшее при обработке вызова.
+     */
+    void fail(std::exception_ptr exception);
+
     /**
      * @brief Функция получения номер звонящего
-     * @return возвращает number_
+     * @return возвращает номер из CDR задачи
+     */
+    const utility::CallerNumber& getNumber();
+
+    /**
+     * @brief Срок ожидания вызова
+     * @return время создания задачи плюс RMax
      */
-    std::string_view getNumber();
+    [[nodiscard]] std::chrono::system_clock::time_point getDeadline() const;
 
 private:
     /// @brief ID вызова.
@@ -63,9 +122,9 @@ private:
     int RMin_;
     /// @brief Нижняя граница.
     int RMax_;
-    /// @brief Номер вызова
-    std::string_view number_;
     std::shared_ptr<spdlog::logger> logger_;
+    /// @brief Генератор длительности разговора.
+    std::shared_ptr<const DurationGenerator> durationGenerator_;
 
     /**
      * @brief Получение ID вызова.
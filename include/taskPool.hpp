@@ -0,0 +1,69 @@
+#ifndef PROTEI_COV_TASKPOOL_HPP
+#define PROTEI_COV_TASKPOOL_HPP
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <string_view>
+
+#include "interfaces.hpp"
+
+/**
+ * @file taskPool.hpp
+ * @brief Содержит объявление класса TaskPool
+ */
+
+namespace TP {
+/**
+ * @brief Класс TaskPool – пул памяти для объектов вызова.
+ * Task вместе с блоком управления shared_ptr размещается в одном блоке фиксированного размера,
+ * промис и общее состояние future – в таких же блоках. Блоки выделяются пластинами (slab)
+ * по blocksPerSlab штук и после завершения вызова возвращаются в список свободных блоков,
+ * поэтому в установившемся режиме создание вызова не обращается к куче.
+ * Пул растет до наибольшего числа одновременных вызовов и не отдает память до уничтожения.
+ * Память пула освобождается после уничтожения TaskPool и всех созданных им объектов.
+ */
+class TaskPool {
+public:
+    static constexpr std::size_t blockSize = 320; ///< Размер блока, запросы большего размера идут в кучу.
+    static constexpr std::size_t blocksPerSlab = 256; ///< Количество блоков в одной пластине.
+
+    /// @brief Конструктор TaskPool.
+    TaskPool();
+
+    /**
+     * @brief Создает задачу в памяти пула.
+     * Промис не создается: результат передается обработчику завершения или промису из makePromise.
+     * @param RMin Нижняя граница времени.
+     * @param RMax Верхняя граница времени.
+     * @param number Номер звонящего.
+     * @param startTime Время создания задачи.
+     * @param logger Логгер.
+     * @return Указатель на задачу.
+     */
+    std::shared_ptr<ITask> makeTask(int RMin, int RMax, std::string_view number,
+                                    const std::chrono::system_clock::time_point& startTime,
+                                    std::shared_ptr<spdlog::logger> logger);
+
+    /**
+     * @brief Создает промис, сам промис и общее состояние future размещаются в памяти пула.
+     * @return Указатель на промис.
+     */
+    std::shared_ptr<std::promise<Result>> makePromise();
+
+    /**
+     * @brief Возвращает количество блоков во всех пластинах пула.
+     * @return Емкость пула в блоках.
+     */
+    [[nodiscard]] std::size_t capacity() const;
+
+private:
+    struct Storage;
+
+    template <class T>
+    class Allocator;
+
+    std::shared_ptr<Storage> storage_; ///< Пластины и список свободных блоков, разделяются с созданными объектами.
+};
+}
+#endif // PROTEI_COV_TASKPOOL_HPP
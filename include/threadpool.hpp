@@ -7,6 +7,7 @@
  */
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <queue>
 #include <thread>
 #include <unordered_map>
@@ -14,8 +15,10 @@
 #include <future>
 #include <tuple>
 
+#include "callIdGenerator.hpp"
 #include "interfaces.hpp"
 #include "recorder.hpp"
+#include "timerWheel.hpp"
 
 /**
  * @namespace TP
@@ -29,12 +32,30 @@ namespace TP {
 struct Thread {
     std::thread _thread; ///< Поток.
     std::atomic<bool> is_working; ///< Флаг, указывающий, обрабатывает ли поток задачу.
+    std::size_t index; ///< Номер потока в пуле, определяет его локальную очередь в ShardedQueue.
+    std::atomic<bool> retired{false}; ///< Флаг, указывающий, что поток завершил работу при уменьшении пула.
 };
 
 
+/**
+ * @brief Режим работы операторов пула.
+ */
+enum class OperatorMode {
+    Threads, ///< Каждый оператор – отдельный поток, который спит на время разговора.
+    TimerWheel ///< Оператор – логический слот, который освобождает колесо таймеров.
+};
+
 /**
  * @class ThreadPool
  * @brief Класс, реализующий пул потоков.
+ * Если очередь задач не требует внешней синхронизации (IQueue::isLockFree),
+ * операторы извлекают задачи без task_queue_mutex, а простаивающие операторы
+ * ожидают через atomic wait/notify вместо общей условной переменной.
+ * В режиме OperatorMode::TimerWheel количество операторов ограничивает число одновременных
+ * вызовов, а не потоков: небольшое число рабочих потоков начинает вызовы, занятые операторы
+ * освобождает колесо таймеров по окончании разговора.
+ * Отдельный поток спит до ближайшего срока ожидания вызова в очереди (IQueue::nextDeadline)
+ * и завершает просроченные вызовы со статусом Timeout, не дожидаясь свободного оператора.
  *
  * @copydoc TP::IThreadPool
  */
@@ -42,9 +63,11 @@ class ThreadPool : public TP::IThreadPool {
 public:
     /**
      * @brief Конструктор.
-     * @param amountOfThreads Количество потоков в пуле.
+     * @param amountOfThreads Количество операторов в пуле.
+     * @param sizeOfQueue Максимальный размер очереди.
+     * @param mode Режим работы операторов.
      */
-    explicit ThreadPool(unsigned amountOfThreads, unsigned sizeOfQueue);
+    explicit ThreadPool(unsigned amountOfThreads, unsigned sizeOfQueue, OperatorMode mode = OperatorMode::Threads);
 
     /**
      * @brief Деструктор.
@@ -58,6 +81,16 @@ public:
      */
     std::pair<CallID, std::future<Result>> add_task(std::shared_ptr<ITask> task) override;
 
+    /**
+     * @copydoc TP::IThreadPool::add_task(std::shared_ptr<ITask>, CompletionHandler)
+     */
+    CallID add_task(std::shared_ptr<ITask> task, CompletionHandler handler) override;
+
+    /**
+     * @copydoc TP::IThreadPool::reject
+     */
+    CallID reject(std::shared_ptr<ITask> task, CallStatus status) override;
+
     /**
      * @brief Остановка пула.
      *
@@ -80,6 +113,17 @@ public:
      */
     void transferObjects(const std::shared_ptr<IThreadPool>& oldThreadPool) override;
 
+    /**
+     * @brief Изменяет количество операторов на месте.
+     * В режиме OperatorMode::Threads запускает новые потоки или помечает лишние потоки на завершение,
+     * поток завершается, когда закончит текущий вызов. В режиме OperatorMode::TimerWheel меняет
+     * ограничение на число одновременных вызовов и, при необходимости, количество рабочих потоков.
+     * @param amountOfOperators Новое количество операторов.
+     *
+     * @copydoc TP::IThreadPool::resize
+     */
+    void resize(unsigned amountOfOperators) override;
+
     /**
      * @brief Установка новой очереди задачи
      * @param task_queue новая очередь задач
@@ -97,12 +141,26 @@ public:
     void setLogger(std::shared_ptr<spdlog::logger> logger);
 
     /**
-     * @brief Возвращает текущие количество потоков.
-     * @return Количество потоков.
+     * @brief Возвращает текущие количество операторов.
+     * @return Количество операторов.
      * @copydoc TP::IThreadPool::getSize
      */
     std::size_t getSize() override;
 
+    /**
+     * @brief Возвращает количество рабочих потоков пула.
+     * В режиме OperatorMode::TimerWheel рабочих потоков может быть меньше, чем операторов.
+     * @return Количество рабочих потоков.
+     */
+    [[nodiscard]] std::size_t getWorkerCount() const;
+
+    /**
+     * @brief Устанавливает генератор CallID. Генератор передается новому пулу в transferObjects,
+     * поэтому CallID остаются возрастающими после пересоздания пула.
+     * @param generator Указатель на генератор CallID.
+     */
+    void setCallIdGenerator(std::shared_ptr<CallIdGenerator> generator);
+
 
 private:
     /**
@@ -116,6 +174,13 @@ private:
      */
     std::vector<Thread*> threads; ///< Вектор операторов.
 
+    /**
+     * @brief Изменение количества потоков без остановки пула.
+     */
+    mutable std::mutex workersMutex_; ///< Мьютекс вектора потоков и счетчика завершаемых потоков.
+    std::atomic<unsigned> retiring_; ///< Количество потоков, которые должны завершиться.
+    std::size_t nextIndex_; ///< Номер следующего запускаемого потока.
+
 
     /**
      * @brief Массив выполненных задач в виде хэш-таблицы.
@@ -138,6 +203,33 @@ private:
     std::atomic<bool> paused; ///< Атомарный флаг для приостановки работы пула.
     std::atomic<bool> waitForCompletion;
 
+    /**
+     * @brief Флаг работы с очередью без блокировок.
+     */
+    std::atomic<bool> lockFree_; ///< Атомарный флаг, очередь задач не требует task_queue_mutex.
+    std::atomic<std::uint32_t> wakeups_; ///< Счетчик пробуждений операторов, на нем ожидают простаивающие операторы.
+    std::atomic<std::uint32_t> queueVersion_; ///< Счетчик замен очереди задач.
+    std::atomic<unsigned> idle_; ///< Количество ожидающих операторов в режиме без блокировок.
+
+    /**
+     * @brief Логические операторы в режиме OperatorMode::TimerWheel.
+     */
+    OperatorMode mode_; ///< Режим работы операторов.
+    std::atomic<unsigned> operators_; ///< Количество операторов.
+    std::atomic<unsigned> busy_; ///< Количество занятых разговором операторов.
+    std::unique_ptr<TimerWheel> wheel_; ///< Колесо таймеров окончания разговоров.
+    std::mutex wheelMutex_; ///< Мьютекс колеса таймеров.
+    std::condition_variable wheelAccess_; ///< Условная переменная ожидания ближайшего таймера.
+    std::thread wheelThread_; ///< Поток, продвигающий колесо таймеров.
+
+    /**
+     * @brief Завершение вызовов, срок ожидания которых истек в очереди.
+     */
+    std::condition_variable deadlineAccess_; ///< Условная переменная ожидания ближайшего срока, используется с task_queue_mutex.
+    std::thread deadlineThread_; ///< Поток, завершающий просроченные вызовы.
+
+    std::shared_ptr<CallIdGenerator> callIdGenerator_; ///< Генератор CallID.
+
     std::shared_ptr<spdlog::logger> logger_; ///< указатель на асинхронный логгер
 
     /**
@@ -146,8 +238,50 @@ private:
      */
     void run(Thread* pOperator);
 
+    /**
+     * @brief Запускает новый поток оператора. Вызывается под workersMutex_.
+     */
+    void spawnWorker();
+
+    /**
+     * @brief Завершает поток оператора, если пул уменьшается.
+     * @param pOperator Указатель на оператора.
+     * @return true, если поток должен завершить работу.
+     */
+    bool retireIfRequested(Thread* pOperator);
+
+    /**
+     * @brief Ожидает и удаляет завершившиеся потоки. Вызывается под workersMutex_.
+     */
+    void reapRetired();
+
+    /**
+     * @brief Возвращает количество работающих потоков без учета завершаемых. Вызывается под workersMutex_.
+     * @return Количество работающих потоков.
+     */
+    [[nodiscard]] std::size_t activeWorkers() const;
+
+    /**
+     * @brief Обработка вызовов в потоке оператора без task_queue_mutex.
+     * @param pOperator Указатель на оператора, обрабатывающего вызов.
+     * @return false, если оператор должен завершить работу.
+     */
+    bool runLockFree(Thread* pOperator);
+
+    /**
+     * @brief Будит всех операторов, как ожидающих на условной переменной, так и на счетчике пробуждений.
+     */
+    void wakeOperators();
+
+    /**
+     * @brief Обновляет режим работы пула после замены очереди задач.
+     * Должен вызываться под task_queue_mutex.
+     */
+    void onQueueChanged();
+
     /**
      * @brief Обрабатывает и подготовляет задачу из очереди пула потоков, к выполнению.
+     * @return Задача и ее CallID, пустой указатель на задачу, если очередь отбросила все ожидавшие задачи.
      */
     std::pair<std::shared_ptr<ITask>, CallID> processTask();
 
@@ -157,11 +291,60 @@ private:
      */
     bool run_allowed() const;
 
+    /**
+     * @brief Проверка, есть ли свободный оператор.
+     * @return true, если вызов можно начать.
+     */
+    bool operatorAvailable() const;
+
+    /**
+     * @brief Занимает оператора в режиме без блокировок.
+     * @return true, если оператор занят, false, если свободных операторов нет.
+     */
+    bool acquireOperator();
+
+    /**
+     * @brief Освобождает операторов и будит рабочие потоки.
+     * @param count Количество освобожденных операторов.
+     */
+    void releaseOperators(std::size_t count);
+
+    /**
+     * @brief Начинает вызов и ставит таймер окончания разговора в колесо таймеров.
+     * @param task Указатель на задачу.
+     * @param callID Идентификатор вызова задачи.
+     */
+    void scheduleTask(const std::shared_ptr<ITask>& task, CallID callID);
+
+    /**
+     * @brief Завершает вызов по срабатыванию таймера.
+     * @param task Указатель на задачу.
+     * @param callID Идентификатор вызова задачи.
+     */
+    void finishTask(const std::shared_ptr<ITask>& task, CallID callID);
+
+    /**
+     * @brief Продвигает колесо таймеров и завершает вызовы, разговор по которым окончен.
+     */
+    void runWheel();
+
+    /**
+     * @brief Ожидает ближайший срок ожидания вызова в очереди и завершает просроченные вызовы.
+     */
+    void runDeadlines();
+
     /**
      * @brief Создание уникального CallID.
      * @return Уникальный CallID.
      */
-    CallID generateCallID(long long number);
+    CallID generateCallID();
+
+    /**
+     * @brief Генерирует CallID и помещает задачу в очередь.
+     * @param task Задача для выполнения в потоке.
+     * @return Уникальный идентификатор вызова.
+     */
+    CallID enqueueTask(const std::shared_ptr<ITask>& task);
 
     /**
      * @brief Выполняет задачу и обрабатывает результат.
@@ -0,0 +1,113 @@
+#ifndef PROTEI_COV_TIMERWHEEL_HPP
+#define PROTEI_COV_TIMERWHEEL_HPP
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @file timerWheel.hpp
+ * @brief Содержит объявление класса TimerWheel
+ */
+
+namespace TP {
+/**
+ * @brief Класс TimerWheel – иерархическое колесо таймеров.
+ * Таймеры раскладываются по уровням из 64 слотов: нулевой уровень хранит таймеры,
+ * которые сработают в ближайшие 64 тика, каждый следующий уровень охватывает в 64 раза
+ * больший интервал. При переходе через границу интервала слот старшего уровня
+ * перераспределяется на младшие уровни, поэтому добавление и срабатывание таймера
+ * выполняются за O(1).
+ * Класс не потокобезопасен, синхронизацию обеспечивает владелец.
+ */
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock; ///< Часы колеса.
+    using Callback = std::function<void()>; ///< Действие, выполняемое по срабатыванию таймера.
+
+    /**
+     * @brief Конструктор класса TimerWheel.
+     * @param tick Длительность одного тика колеса.
+     * @param start Момент времени, соответствующий нулевому тику.
+     */
+    explicit TimerWheel(Clock::duration tick = std::chrono::milliseconds{10}, Clock::time_point start = Clock::now());
+
+    /**
+     * @brief Добавляет таймер.
+     * Таймеры с задержкой больше охвата колеса срабатывают по достижении охвата (около 46 часов при тике 10 мс).
+     * @param now Текущее время.
+     * @param delay Задержка срабатывания.
+     * @param callback Действие, выполняемое по срабатыванию таймера.
+     */
+    void schedule(Clock::time_point now, Clock::duration delay, Callback callback);
+
+    /**
+     * @brief Продвигает колесо до указанного момента времени.
+     * @param now Текущее время.
+     * @return Действия сработавших таймеров.
+     */
+    std::vector<Callback> advance(Clock::time_point now);
+
+    /**
+     * @brief Возвращает момент, к которому нужно продвинуть колесо в следующий раз.
+     * @return Время ближайшего срабатывания или перераспределения таймеров,
+     * Clock::time_point::max(), если таймеров нет.
+     */
+    [[nodiscard]] Clock::time_point nextExpiry() const;
+
+    /**
+     * @brief Проверяет, есть ли в колесе таймеры.
+     * @return true, если таймеров нет.
+     */
+    [[nodiscard]] bool empty() const;
+
+    /**
+     * @brief Возвращает количество таймеров в колесе.
+     * @return Количество таймеров.
+     */
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    /**
+     * @brief Таймер в слоте колеса.
+     */
+    struct Timer {
+        std::uint64_t expiry; ///< Тик срабатывания.
+        Callback callback; ///< Действие по срабатыванию.
+    };
+
+    /**
+     * @brief Помещает таймер в слот, соответствующий его тику срабатывания.
+     * @param timer Таймер.
+     * @param expired Действия таймеров, тик которых уже наступил.
+     */
+    void insert(Timer&& timer, std::vector<Callback>& expired);
+
+    /**
+     * @brief Перераспределяет таймеры слота на младшие уровни.
+     * @param level Уровень колеса.
+     * @param expired Действия таймеров, тик которых уже наступил.
+     */
+    void cascade(unsigned level, std::vector<Callback>& expired);
+
+    /**
+     * @brief Переводит момент времени в номер тика.
+     * @param time Момент времени.
+     * @return Номер тика.
+     */
+    [[nodiscard]] std::uint64_t ticksAt(Clock::time_point time) const;
+
+    static constexpr unsigned levels = 4; ///< Количество уровней колеса.
+    static constexpr unsigned slotBits = 6; ///< Разрядность номера слота.
+    static constexpr std::uint64_t slots = 1u << slotBits; ///< Количество слотов на уровне.
+    static constexpr std::uint64_t slotMask = slots - 1; ///< Маска номера слота.
+
+    std::array<std::array<std::vector<Timer>, slots>, levels> wheel_; ///< Слоты колеса по уровням.
+    Clock::duration tick_; ///< Длительность тика.
+    Clock::time_point start_; ///< Момент нулевого тика.
+    std::uint64_t current_ = 0; ///< Текущий тик.
+    std::size_t size_ = 0; ///< Количество таймеров.
+};
+}
+#endif // PROTEI_COV_TIMERWHEEL_HPP
@@ -0,0 +1,26 @@
+#include "admissionGate.hpp"
+
+/**
+ * @file admissionGate.cpp
+ * @brief Содержит определение класса AdmissionGate
+ */
+
+using namespace TP;
+
+bool AdmissionGate::tryEnter(std::size_t limit) {
+    auto current = inFlight_.load(std::memory_order_relaxed);
+    do {
+        if (current >= limit)
+            return false;
+    } while (!inFlight_.compare_exchange_weak(current, current + 1, std::memory_order_acquire,
+                                              std::memory_order_relaxed));
+    return true;
+}
+
+void AdmissionGate::leave() {
+    inFlight_.fetch_sub(1, std::memory_order_release);
+}
+
+std::size_t AdmissionGate::inFlight() const {
+    return inFlight_.load(std::memory_order_relaxed);
+}
@@ -10,14 +10,14 @@
  * частично реализующий паттерн Строитель.
  */
 
-std::shared_ptr<spdlog::logger> ManagerBuilder::BuildLogger() {
-    auto file_sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>("logfile.txt", true);
+std::shared_ptr<spdlog::logger> ManagerBuilder::BuildLogger(spdlog::async_overflow_policy policy) {
+    if(sinks.empty()) {
+        sinks.push_back(std::make_shared<spdlog::sinks::basic_file_sink_mt>("logfile.txt", true));
+        sinks.push_back(std::make_shared<spdlog::sinks::ansicolor_stdout_sink_mt>());
+    }
 
     auto async_logger = std::make_shared<spdlog::async_logger>(
-        "async_logger",
-        spdlog::sinks_init_list{file_sink, std::make_shared<spdlog::sinks::ansicolor_stdout_sink_mt>()},
-        spdlog::thread_pool(),
-        spdlog::async_overflow_policy::block);
+        "async_logger", sinks.begin(), sinks.end(), spdlog::thread_pool(), policy);
 
     async_logger->set_level(spdlog::level::debug);
 
@@ -44,8 +44,13 @@ std::vector<std::shared_ptr<IRecorder>> ManagerBuilder::BuildRecorders() {
         if(recorders.empty()) {
             logger->info("Built recorders");
             recorders = std::vector<std::shared_ptr<IRecorder>>{};
-            auto fileRecorder = std::make_shared<FileRecorder>("cdrFile.txt");
+            auto fileRecorder = std::make_shared<AsyncFileRecorder>(
+                "cdrFile.txt", static_cast<CdrDurability>(config->getCdrDurability()),
+                static_cast<std::size_t>(config->getCdrBatchSize()),
+                std::chrono::milliseconds{config->getCdrFlushInterval()});
             recorders.push_back(fileRecorder);
+            metrics = std::make_shared<utility::CallMetrics>();
+            recorders.push_back(metrics);
 
             for(const auto& recorder: recorders)
                 recorder->setLogger(logger);
@@ -59,9 +64,43 @@ std::vector<std::shared_ptr<IRecorder>> ManagerBuilder::BuildRecorders() {
 
 std::shared_ptr<TP::ThreadPool> ManagerBuilder::BuildThreadPool() {
     try {
-        auto pool = std::make_shared<TP::ThreadPool>(config->getAmountOfOperators(), config->getSizeOfQueue());
-        logger->info("Built thread pool");
+        auto mode = (config->getOperatorMode() == 1) ? TP::OperatorMode::TimerWheel : TP::OperatorMode::Threads;
+        auto pool = std::make_shared<TP::ThreadPool>(config->getAmountOfOperators(), config->getSizeOfQueue(), mode);
+        if (config->getQueueType() == 1) {
+            pool->setTaskQueue(std::make_shared<TP::LockFreeQueue>(config->getSizeOfQueue()));
+            logger->info("Thread pool uses lock-free task queue");
+        } else if (config->getQueueType() == 2) {
+            pool->setTaskQueue(std::make_shared<TP::ShardedQueue>(config->getSizeOfQueue(), pool->getWorkerCount()));
+            logger->info("Thread pool uses sharded task queue with {} local queues", pool->getWorkerCount());
+        } else if (auto snapshot = config->getSnapshot(); !snapshot->priorityPrefixes.empty()) {
+            auto rules = std::make_shared<utility::PrefixTrie>();
+            for (const auto& [prefix, priority]: snapshot->priorityPrefixes)
+                rules->insert(prefix, priority);
+            rules->compact();
+            auto queue = std::make_shared<TP::PriorityQueue>(
+                    config->getSizeOfQueue(), rules,
+                    std::array<unsigned, priorityClassCount>{static_cast<unsigned>(snapshot->priorityWeightNormal),
+                                                             static_cast<unsigned>(snapshot->priorityWeightVip),
+                                                             static_cast<unsigned>(snapshot->priorityWeightEmergency)});
+            if (snapshot->queueDiscipline == 1)
+                queue->setCodel(std::chrono::milliseconds{snapshot->codelTarget}, std::chrono::milliseconds{snapshot->codelInterval});
+            if (metrics)
+                metrics->setClassDepth([queue](PriorityClass priority) { return queue->depth(priority); });
+            pool->setTaskQueue(queue);
+            logger->info("Thread pool uses priority queue with {} prefixes, weights {}/{}/{}", rules->size(),
+                         snapshot->priorityWeightNormal, snapshot->priorityWeightVip, snapshot->priorityWeightEmergency);
+        } else if (snapshot->queueDiscipline == 1) {
+            auto queue = std::make_shared<TP::Queue>(config->getSizeOfQueue());
+            queue->setCodel(std::chrono::milliseconds{snapshot->codelTarget}, std::chrono::milliseconds{snapshot->codelInterval});
+            pool->setTaskQueue(queue);
+            logger->info("Thread pool uses task queue with CoDel, target {} ms, interval {} ms",
+                         snapshot->codelTarget, snapshot->codelInterval);
+        }
+        callIdGenerator = std::make_shared<TP::CallIdGenerator>(config->getNodeID());
+        pool->setCallIdGenerator(callIdGenerator);
+        logger->info("Built thread pool with NodeID {}", config->getNodeID());
         pool->setLogger(logger);
+        pool->task_queue->setRecorders(recorders);
         return pool;
     } catch (std::exception& e) {
         logger->critical("Critical error building thread pool: {}", e.what());
@@ -73,6 +112,7 @@ std::shared_ptr<Manager> ManagerBuilder::Construct(const std::filesystem::path&
     try {
         logger = BuildLogger();
         config = BuildConfig(pathToConfig);
+        ApplyLogSettings();
         BuildRecorders();
         auto pool = BuildThreadPool();
 
@@ -90,4 +130,31 @@ std::shared_ptr<Manager> ManagerBuilder::Construct(const std::filesystem::path&
 
         throw e;
     }
-}
\ No newline at end of file
+}
+
+void ManagerBuilder::ApplyLogSettings() {
+    // Поведение при переполнении задается только при создании асинхронного логгера, поэтому он пересоздается.
+    if(config->getLogOverflowPolicy() == 1) {
+        logger = BuildLogger(spdlog::async_overflow_policy::overrun_oldest);
+        config->setLogger(logger);
+    }
+    logger->set_level(static_cast<spdlog::level::level_enum>(config->getLogLevel()));
+    logger->info("Log level {}, overflow policy {}", spdlog::level::to_string_view(logger->level()),
+                 config->getLogOverflowPolicy() == 1 ? "overrun oldest" : "block");
+}
+
+std::shared_ptr<spdlog::logger> ManagerBuilder::GetLogger() const {
+    return logger;
+}
+
+std::shared_ptr<utility::ThreadSafeConfig> ManagerBuilder::GetConfig() const {
+    return config;
+}
+
+std::shared_ptr<utility::CallMetrics> ManagerBuilder::GetMetrics() const {
+    return metrics;
+}
+
+std::shared_ptr<TP::CallIdGenerator> ManagerBuilder::GetCallIdGenerator() const {
+    return callIdGenerator;
+}
@@ -0,0 +1,45 @@
+#include "callIdGenerator.hpp"
+
+#include <algorithm>
+
+/**
+ * @file callIdGenerator.cpp
+ * @brief Содержит определение класса CallIdGenerator
+ */
+
+using namespace TP;
+
+namespace {
+constexpr unsigned timestampShift = CallIdGenerator::sequenceBits + CallIdGenerator::nodeBits;
+constexpr std::uint64_t sequenceMask = (std::uint64_t{1} << CallIdGenerator::sequenceBits) - 1;
+}
+
+CallIdGenerator::CallIdGenerator(std::uint64_t nodeID) : nodeID_(nodeID & maxNodeID), last_(0) { }
+
+CallID CallIdGenerator::next() {
+    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()) - epoch;
+    // Состояние хранит время и номер вызова подряд, без битов узла, поэтому переполнение номера
+    // переходит в следующую миллисекунду.
+    auto fromClock = static_cast<std::uint64_t>(std::max<std::int64_t>(now.count(), 0)) << sequenceBits;
+    auto last = last_.load(std::memory_order_relaxed);
+    std::uint64_t value;
+    do {
+        value = std::max(fromClock, last + 1);
+    } while (!last_.compare_exchange_weak(last, value, std::memory_order_relaxed));
+
+    auto millis = value >> sequenceBits;
+    return (millis << timestampShift) | (nodeID_ << sequenceBits) | (value & sequenceMask);
+}
+
+std::uint64_t CallIdGenerator::nodeID() const {
+    return nodeID_;
+}
+
+std::chrono::system_clock::time_point CallIdGenerator::timestamp(CallID id) {
+    return std::chrono::system_clock::time_point{epoch + std::chrono::milliseconds{id >> timestampShift}};
+}
+
+std::uint64_t CallIdGenerator::node(CallID id) {
+    return (id >> sequenceBits) & maxNodeID;
+}
@@ -0,0 +1,128 @@
+#include "callMetrics.hpp"
+#include "cdrFormatter.hpp"
+
+#include <charconv>
+
+/**
+ * @file callMetrics.cpp
+ * @brief Содержит определение класса CallMetrics
+ */
+
+using namespace utility;
+
+namespace {
+/// Границы корзин Prometheus: степени двойки микросекунд от 16 мкс до 268 с совпадают с границами корзин гистограммы.
+constexpr unsigned firstBoundShift = 4;
+constexpr unsigned lastBoundShift = 28;
+
+std::chrono::microseconds elapsed(std::chrono::system_clock::time_point from, std::chrono::system_clock::time_point to) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(to - from);
+}
+
+void appendNumber(std::string& out, std::uint64_t value) {
+    char buffer[24];
+    auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, ptr);
+}
+
+void appendSeconds(std::string& out, std::uint64_t micros) {
+    char buffer[32];
+    auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<double>(micros) / 1e6);
+    out.append(buffer, ptr);
+}
+
+constexpr std::array<std::string_view, priorityClassCount> classNames{"normal", "vip", "emergency"};
+
+void appendHeader(std::string& out, std::string_view name, std::string_view help, std::string_view type) {
+    out.append("# HELP ").append(name).append(" ").append(help).append("\n");
+    out.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+}
+
+/// Дописывает ряд гистограммы, labels – метки ряда без фигурных скобок, например class="vip".
+void appendSeries(std::string& out, std::string_view name, std::string_view labels, const LatencyHistogram& histogram) {
+    auto snapshot = histogram.snapshot();
+    auto labelPrefix = labels.empty() ? std::string{} : std::string{labels} + ",";
+    auto labelSet = labels.empty() ? std::string{} : "{" + std::string{labels} + "}";
+    for (unsigned shift = firstBoundShift; shift <= lastBoundShift; ++shift) {
+        std::uint64_t bound = std::uint64_t{1} << shift;
+        out.append(name).append("_bucket{").append(labelPrefix).append("le=\"");
+        appendSeconds(out, bound);
+        out.append("\"} ");
+        appendNumber(out, snapshot.countAtMost(bound - 1));
+        out += '\n';
+    }
+    out.append(name).append("_bucket{").append(labelPrefix).append("le=\"+Inf\"} ");
+    appendNumber(out, snapshot.count);
+    out += '\n';
+    out.append(name).append("_sum").append(labelSet).append(" ");
+    appendSeconds(out, snapshot.sum);
+    out += '\n';
+    out.append(name).append("_count").append(labelSet).append(" ");
+    appendNumber(out, snapshot.count);
+    out += '\n';
+}
+
+void appendHistogram(std::string& out, std::string_view name, std::string_view help, const LatencyHistogram& histogram) {
+    appendHeader(out, name, help, "histogram");
+    appendSeries(out, name, {}, histogram);
+}
+}
+
+void CallMetrics::makeRecord(const CDR& cdr) {
+    calls_[static_cast<std::size_t>(cdr.status) % statusCount].fetch_add(1, std::memory_order_relaxed);
+    // Отклоненные вызовы не доходят до оператора, поэтому в гистограммы попадают только обслуженные.
+    if (cdr.status != CallStatus::Completed && cdr.status != CallStatus::Timeout)
+        return;
+    queueWait_.record(elapsed(cdr.startTime, cdr.operatorCallTime));
+    classQueueWait_[static_cast<std::size_t>(cdr.priority) % priorityClassCount].record(
+            elapsed(cdr.startTime, cdr.operatorCallTime));
+    service_.record(elapsed(cdr.operatorCallTime, cdr.endTime));
+    endToEnd_.record(elapsed(cdr.startTime, cdr.endTime));
+}
+
+void CallMetrics::setClassDepth(std::function<std::size_t(PriorityClass)> depth) {
+    classDepth_ = std::move(depth);
+}
+
+void CallMetrics::flush() {
+}
+
+void CallMetrics::setLogger(std::shared_ptr<spdlog::logger> logger) {
+    logger_ = logger;
+}
+
+void CallMetrics::recordHttpRequest(std::chrono::microseconds duration) {
+    httpRequest_.record(duration);
+}
+
+std::string CallMetrics::prometheus() const {
+    std::string out;
+    out.reserve(16 * 1024);
+    appendHistogram(out, "protei_cov_queue_wait_seconds", "Time a call waited in the queue for an operator.",
+                    queueWait_);
+    appendHistogram(out, "protei_cov_service_seconds", "Time an operator spent serving a call.", service_);
+    appendHistogram(out, "protei_cov_call_seconds", "Time from call arrival to call termination.", endToEnd_);
+    appendHistogram(out, "protei_cov_http_request_seconds", "Time from HTTP request arrival to response readiness.",
+                    httpRequest_);
+    out.append("# HELP protei_cov_calls_total Calls by final status.\n");
+    out.append("# TYPE protei_cov_calls_total counter\n");
+    for (std::size_t i = 0; i < statusCount; ++i) {
+        out.append("protei_cov_calls_total{status=\"").append(statusName(static_cast<CallStatus>(i))).append("\"} ");
+        appendNumber(out, calls_[i].load(std::memory_order_relaxed));
+        out += '\n';
+    }
+    if (!classDepth_)
+        return out;
+    appendHeader(out, "protei_cov_class_queue_wait_seconds",
+                 "Time a call waited in the queue for an operator by priority class.", "histogram");
+    for (std::size_t i = 0; i < priorityClassCount; ++i)
+        appendSeries(out, "protei_cov_class_queue_wait_seconds",
+                     "class=\"" + std::string{classNames[i]} + "\"", classQueueWait_[i]);
+    appendHeader(out, "protei_cov_class_queue_depth", "Calls waiting in the queue by priority class.", "gauge");
+    for (std::size_t i = 0; i < priorityClassCount; ++i) {
+        out.append("protei_cov_class_queue_depth{class=\"").append(classNames[i]).append("\"} ");
+        appendNumber(out, classDepth_(static_cast<PriorityClass>(i)));
+        out += '\n';
+    }
+    return out;
+}
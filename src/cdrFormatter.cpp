@@ -0,0 +1,116 @@
+#include "cdrFormatter.hpp"
+
+#include <charconv>
+#include <cstring>
+
+/**
+ * @file cdrFormatter.cpp
+ * @brief Содержит определение класса CdrFormatter
+ */
+
+using namespace utility;
+
+namespace {
+char* putChar(char* first, char* last, char c) {
+    if (!first || first == last)
+        return nullptr;
+    *first = c;
+    return first + 1;
+}
+
+char* putText(char* first, char* last, std::string_view text) {
+    if (!first || static_cast<std::size_t>(last - first) < text.size())
+        return nullptr;
+    std::memcpy(first, text.data(), text.size());
+    return first + text.size();
+}
+
+template<typename T>
+char* putNumber(char* first, char* last, T value) {
+    if (!first)
+        return nullptr;
+    auto [ptr, ec] = std::to_chars(first, last, value);
+    return ec == std::errc{} ? ptr : nullptr;
+}
+
+/// Записывает число с ведущими нулями до указанной ширины, число должно в нее помещаться.
+void putPadded(char* first, int value, int width) {
+    for (int i = width - 1; i >= 0; --i) {
+        first[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+}
+
+std::string_view utility::statusName(CallStatus status) {
+    switch (status) {
+    case CallStatus::Awaiting: return "Awaiting";
+    case CallStatus::Completed: return "Completed";
+    case CallStatus::Duplication: return "Duplication";
+    case CallStatus::Overloaded: return "Overloaded";
+    case CallStatus::Rejected: return "Rejected";
+    case CallStatus::Timeout: return "Timeout";
+    }
+    return "Null";
+}
+
+std::size_t CdrFormatter::maxSize(const CDR& cdr) {
+    return fixedSize + cdr.number.size();
+}
+
+const CdrFormatter::Prefix& CdrFormatter::prefix(std::time_t second) {
+    auto& entry = cache_[static_cast<std::size_t>(second) % cacheSize];
+    if (entry.second != second) {
+        std::tm timeInfo{};
+        localtime_r(&second, &timeInfo);
+        auto* text = entry.text.data();
+        putPadded(text, (timeInfo.tm_year + 1900) % 10000, 4);
+        text[4] = '-';
+        putPadded(text + 5, timeInfo.tm_mon + 1, 2);
+        text[7] = '-';
+        putPadded(text + 8, timeInfo.tm_mday, 2);
+        text[10] = ' ';
+        putPadded(text + 11, timeInfo.tm_hour, 2);
+        text[13] = ':';
+        putPadded(text + 14, timeInfo.tm_min, 2);
+        text[16] = ':';
+        putPadded(text + 17, timeInfo.tm_sec, 2);
+        entry.second = second;
+    }
+    return entry;
+}
+
+char* CdrFormatter::formatTime(char* first, char* last, const std::chrono::system_clock::time_point& time) {
+    if (time == std::chrono::system_clock::time_point())
+        return first;
+    if (!first || static_cast<std::size_t>(last - first) < prefixSize + 4)
+        return nullptr;
+
+    auto sinceEpoch = time.time_since_epoch();
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(sinceEpoch);
+    auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(sinceEpoch - seconds);
+    const auto& cached = prefix(std::chrono::system_clock::to_time_t(time));
+    std::memcpy(first, cached.text.data(), prefixSize);
+    first[prefixSize] = '.';
+    putPadded(first + prefixSize + 1, static_cast<int>(milliseconds.count()), 3);
+    return first + prefixSize + 4;
+}
+
+char* CdrFormatter::format(char* first, char* last, const CDR& cdr) {
+    auto* out = formatTime(first, last, cdr.startTime);
+    out = putChar(out, last, ';');
+    out = putNumber(out, last, cdr.callID);
+    out = putChar(out, last, ';');
+    out = putText(out, last, cdr.number.view());
+    out = putChar(out, last, ';');
+    out = out ? formatTime(out, last, cdr.endTime) : nullptr;
+    out = putChar(out, last, ';');
+    out = putText(out, last, statusName(cdr.status));
+    out = putChar(out, last, ';');
+    out = out ? formatTime(out, last, cdr.operatorCallTime) : nullptr;
+    out = putChar(out, last, ';');
+    out = putNumber(out, last, cdr.operatorID);
+    out = putChar(out, last, ';');
+    out = putNumber(out, last, cdr.callDuration.count());
+    return putChar(out, last, 's');
+}
@@ -1,4 +1,6 @@
 #include "commonStructures.hpp"
+#include "cdrFormatter.hpp"
+#include <stdexcept>
 
 /** @file commonStructures.cpp
  *  @brief Содержит определение функций необходимых для работы
@@ -7,6 +9,13 @@
 
 namespace utility {
 using std::string_literals::operator""s;
+CallerNumber::CallerNumber(std::string_view number) {
+    if (number.size() > maxLength)
+        throw std::length_error("caller number is longer than "s + std::to_string(maxLength) + " characters");
+    std::memcpy(data_.data(), number.data(), number.size());
+    data_[maxLength] = static_cast<char>(number.size());
+}
+
 std::string to_string(const CallStatus& status) {
     switch (status) {
     case CallStatus::Awaiting: return "Awaiting"s; break;
@@ -46,8 +55,16 @@ std::string prepareTime(const time_point& timeP) {
 }
 
 std::ofstream& operator<<(std::ofstream& out, const CDR& cdr) {
-    out << utility::prepareTime(cdr.startTime) << ";" << cdr.callID << ";" << std::string{cdr.number} << ";" << utility::prepareTime(cdr.endTime) << ";";
-    out << utility::to_string(cdr.status) << ";" << utility::prepareTime(cdr.operatorCallTime) << ";" << cdr.operatorID << ";";
-    out << cdr.callDuration.count() << "s";
+    std::string record;
+    utility::appendCDR(record, cdr);
+    out << record;
     return out;
-}
\ No newline at end of file
+}
+
+void utility::appendCDR(std::string& out, const CDR& cdr) {
+    thread_local CdrFormatter formatter;
+    auto offset = out.size();
+    out.resize(offset + CdrFormatter::maxSize(cdr));
+    auto* end = formatter.format(out.data() + offset, out.data() + out.size(), cdr);
+    out.resize(end ? static_cast<std::size_t>(end - out.data()) : offset);
+}
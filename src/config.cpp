@@ -1,5 +1,15 @@
 #include "config.hpp"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <system_error>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
 
 /**
  * @file config.cpp
@@ -27,6 +37,16 @@ Config::Config(const std::filesystem::path &path, std::shared_ptr<spdlog::logger
         data_["SizeOfQueue"] = 15;
         notToUpdate = true;
     }
+    normalizeHttpSettings();
+    normalizeQueueType();
+    normalizeQueueDiscipline();
+    normalizePriorityClasses();
+    normalizeNumberFilter();
+    normalizeOperatorMode();
+    normalizeCdrSettings();
+    normalizeNodeID();
+    normalizeLogSettings();
+    normalizeDurationSettings();
 }
 
 std::pair<int, int> Config::getMinMax() {
@@ -41,10 +61,54 @@ int Config::getSizeOfQueue() {
     return data_["SizeOfQueue"];
 }
 
+int Config::getKeepAliveTimeout() {
+    return data_["KeepAliveTimeout"];
+}
+
+int Config::getMaxRequestsPerConnection() {
+    return data_["MaxRequestsPerConnection"];
+}
+
+int Config::getQueueType() {
+    return data_["QueueType"];
+}
+
+int Config::getOperatorMode() {
+    return data_["OperatorMode"];
+}
+
+int Config::getCdrDurability() {
+    return data_["CdrDurability"];
+}
+
+int Config::getCdrFlushInterval() {
+    return data_["CdrFlushInterval"];
+}
+
+int Config::getCdrBatchSize() {
+    return data_["CdrBatchSize"];
+}
+
+int Config::getNodeID() {
+    return data_["NodeID"];
+}
+
+int Config::getLogLevel() {
+    return data_["LogLevel"];
+}
+
+int Config::getLogOverflowPolicy() {
+    return data_["LogOverflowPolicy"];
+}
+
 std::filesystem::path Config::getPath() {
     return path_;
 }
 
+std::shared_ptr<const ConfigSnapshot> Config::getSnapshot() {
+    return std::make_shared<const ConfigSnapshot>(ConfigSnapshot::fromData(data_, path_));
+}
+
 bool Config::isUpdated() {
     return false;
 }
@@ -67,7 +131,8 @@ void Config::updateWithRequest() {
 }
 
 void Config::notify() {
-    manager->update();
+    if(auto current = manager.lock())
+        current->update();
 }
 
 void Config::setManager(std::shared_ptr<IManager> manager) {
@@ -94,6 +159,16 @@ void Config::normalizeData() {
     normalizeRMinRMax();
     normalizeAmountOfOperators();
     normalizeSizeOfQueue();
+    normalizeHttpSettings();
+    normalizeQueueType();
+    normalizeQueueDiscipline();
+    normalizePriorityClasses();
+    normalizeNumberFilter();
+    normalizeOperatorMode();
+    normalizeCdrSettings();
+    normalizeNodeID();
+    normalizeLogSettings();
+    normalizeDurationSettings();
 }
 
 void Config::normalizeRMinRMax() {
@@ -120,8 +195,10 @@ void Config::normalizeRMinRMax() {
 void Config::normalizeAmountOfOperators() {
     if(logger_)
         logger_->info("Normalizing AmountOfOperators");
-    if(data_["AmountOfOperators"] >= 80)
-        data_["AmountOfOperators"] = 80;
+    // В режиме колеса таймеров операторы – логические слоты, а не потоки.
+    auto maxOperators = (data_["OperatorMode"] == 1) ? 100000 : 80;
+    if(data_["AmountOfOperators"] >= maxOperators)
+        data_["AmountOfOperators"] = maxOperators;
     if(data_["AmountOfOperators"] <= 2)
         data_["AmountOfOperators"] = 2;
 
@@ -145,6 +222,211 @@ void Config::normalizeSizeOfQueue() {
     }
 }
 
+void Config::normalizeHttpSettings() {
+    if(logger_)
+        logger_->info("Normalizing KeepAliveTimeout MaxRequestsPerConnection");
+
+    if(data_["KeepAliveTimeout"] <= 0)
+        data_["KeepAliveTimeout"] = 30;
+    if(data_["KeepAliveTimeout"] >= 3600)
+        data_["KeepAliveTimeout"] = 3600;
+    if(data_["MaxRequestsPerConnection"] <= 0)
+        data_["MaxRequestsPerConnection"] = 1000;
+    if(data_["MaxRequestsPerConnection"] >= 100000)
+        data_["MaxRequestsPerConnection"] = 100000;
+
+    if(logger_) {
+        logger_->debug("KeepAliveTimeout: {} MaxRequestsPerConnection: {} after normalizing",
+                       data_["KeepAliveTimeout"], data_["MaxRequestsPerConnection"]);
+    }
+}
+
+void Config::normalizeQueueType() {
+    if(logger_)
+        logger_->info("Normalizing QueueType");
+
+    if(data_["QueueType"] < 0 || data_["QueueType"] > 2)
+        data_["QueueType"] = 0;
+
+    if(logger_) {
+        logger_->debug("QueueType: {} after normalizing", data_["QueueType"]);
+    }
+}
+
+void Config::normalizeQueueDiscipline() {
+    if(logger_)
+        logger_->info("Normalizing QueueDiscipline CodelTarget CodelInterval");
+
+    if(data_["QueueDiscipline"] != 1)
+        data_["QueueDiscipline"] = 0;
+    if(data_["CodelTarget"] <= 0)
+        data_["CodelTarget"] = 5000;
+    if(data_["CodelTarget"] >= 600000)
+        data_["CodelTarget"] = 600000;
+    if(data_["CodelInterval"] <= 0)
+        data_["CodelInterval"] = 15000;
+    if(data_["CodelInterval"] >= 3600000)
+        data_["CodelInterval"] = 3600000;
+    // Интервал короче целевой задержки не дает очереди накопить задержку target до первого отбрасывания.
+    if(data_["CodelInterval"] < data_["CodelTarget"])
+        data_["CodelInterval"] = data_["CodelTarget"];
+
+    if(logger_) {
+        logger_->debug("QueueDiscipline: {} CodelTarget: {} CodelInterval: {} after normalizing",
+                       data_["QueueDiscipline"], data_["CodelTarget"], data_["CodelInterval"]);
+    }
+}
+
+void Config::normalizePriorityClasses() {
+    if(logger_)
+        logger_->info("Normalizing PriorityPrefixes PriorityWeightNormal PriorityWeightVip PriorityWeightEmergency");
+
+    const std::string prefixes = "PriorityPrefixes.";
+    for (auto it = data_.lower_bound(prefixes); it != data_.end() && it->first.starts_with(prefixes);) {
+        auto prefix = std::string_view{it->first}.substr(prefixes.size());
+        if (prefix.empty() || prefix.size() > utility::CallerNumber::maxLength ||
+            prefix.find_first_not_of("0123456789") != std::string_view::npos) {
+            if(logger_)
+                logger_->warn("Ignoring priority prefix {}: only digits up to {} characters are allowed",
+                              prefix, utility::CallerNumber::maxLength);
+            it = data_.erase(it);
+            continue;
+        }
+        it->second = std::clamp(it->second, 0, static_cast<int>(priorityClassCount) - 1);
+        ++it;
+    }
+
+    auto normalizeWeight = [this](const std::string& key, int byDefault) {
+        if(data_[key] <= 0)
+            data_[key] = byDefault;
+        if(data_[key] >= 1000)
+            data_[key] = 1000;
+    };
+    normalizeWeight("PriorityWeightNormal", 1);
+    normalizeWeight("PriorityWeightVip", 4);
+    normalizeWeight("PriorityWeightEmergency", 16);
+
+    if(logger_) {
+        logger_->debug("PriorityWeightNormal: {} PriorityWeightVip: {} PriorityWeightEmergency: {} after normalizing",
+                       data_["PriorityWeightNormal"], data_["PriorityWeightVip"], data_["PriorityWeightEmergency"]);
+    }
+}
+
+void Config::normalizeNumberFilter() {
+    if(logger_)
+        logger_->info("Normalizing NumberFilter NumberFilterMode");
+
+    const std::string prefixes = "NumberFilter.";
+    for (auto it = data_.lower_bound(prefixes); it != data_.end() && it->first.starts_with(prefixes);) {
+        auto prefix = std::string_view{it->first}.substr(prefixes.size());
+        if (prefix.empty() || prefix.size() > utility::CallerNumber::maxLength ||
+            prefix.find_first_not_of("0123456789") != std::string_view::npos) {
+            if(logger_)
+                logger_->warn("Ignoring number filter prefix {}: only digits up to {} characters are allowed",
+                              prefix, utility::CallerNumber::maxLength);
+            it = data_.erase(it);
+            continue;
+        }
+        if (it->second != 0)
+            it->second = 1;
+        ++it;
+    }
+
+    if(data_["NumberFilterMode"] != 1)
+        data_["NumberFilterMode"] = 0;
+
+    if(logger_) {
+        logger_->debug("NumberFilterMode: {} after normalizing", data_["NumberFilterMode"]);
+    }
+}
+
+void Config::normalizeOperatorMode() {
+    if(logger_)
+        logger_->info("Normalizing OperatorMode");
+
+    if(data_["OperatorMode"] != 1)
+        data_["OperatorMode"] = 0;
+
+    if(logger_) {
+        logger_->debug("OperatorMode: {} after normalizing", data_["OperatorMode"]);
+    }
+}
+
+void Config::normalizeCdrSettings() {
+    if(logger_)
+        logger_->info("Normalizing CdrDurability CdrFlushInterval CdrBatchSize");
+
+    if(data_["CdrDurability"] < 0 || data_["CdrDurability"] > 2)
+        data_["CdrDurability"] = 0;
+    if(data_["CdrFlushInterval"] <= 0)
+        data_["CdrFlushInterval"] = 50;
+    if(data_["CdrFlushInterval"] >= 10000)
+        data_["CdrFlushInterval"] = 10000;
+    if(data_["CdrBatchSize"] <= 0)
+        data_["CdrBatchSize"] = 65536;
+    if(data_["CdrBatchSize"] <= 4096)
+        data_["CdrBatchSize"] = 4096;
+    if(data_["CdrBatchSize"] >= 16777216)
+        data_["CdrBatchSize"] = 16777216;
+
+    if(logger_) {
+        logger_->debug("CdrDurability: {} CdrFlushInterval: {} CdrBatchSize: {} after normalizing",
+                       data_["CdrDurability"], data_["CdrFlushInterval"], data_["CdrBatchSize"]);
+    }
+}
+
+void Config::normalizeNodeID() {
+    if(logger_)
+        logger_->info("Normalizing NodeID");
+
+    if(data_["NodeID"] < 0 || data_["NodeID"] > 1023)
+        data_["NodeID"] = 0;
+
+    if(logger_) {
+        logger_->debug("NodeID: {} after normalizing", data_["NodeID"]);
+    }
+}
+
+void Config::normalizeLogSettings() {
+    if(logger_)
+        logger_->info("Normalizing LogLevel and LogOverflowPolicy");
+
+    // 0 - допустимый уровень trace, поэтому отсутствие ключа проверяется отдельно.
+    if(!data_.contains("LogLevel") || data_["LogLevel"] < 0 || data_["LogLevel"] > 6)
+        data_["LogLevel"] = 1;
+    if(data_["LogOverflowPolicy"] < 0 || data_["LogOverflowPolicy"] > 1)
+        data_["LogOverflowPolicy"] = 0;
+
+    if(logger_) {
+        logger_->debug("LogLevel: {} LogOverflowPolicy: {} after normalizing",
+                       data_["LogLevel"], data_["LogOverflowPolicy"]);
+    }
+}
+
+void Config::normalizeDurationSettings() {
+    if(logger_)
+        logger_->info("Normalizing DurationDistribution DurationMean DurationSigma DurationSeed");
+
+    if(data_["DurationDistribution"] < 0 || data_["DurationDistribution"] > 2)
+        data_["DurationDistribution"] = 0;
+    // 0 - среднее в середине [RMin, RMax], значения распределения все равно ограничиваются этим диапазоном.
+    if(data_["DurationMean"] < 0)
+        data_["DurationMean"] = 0;
+    if(data_["DurationMean"] >= 140)
+        data_["DurationMean"] = 140;
+    if(data_["DurationSigma"] <= 0)
+        data_["DurationSigma"] = 50;
+    if(data_["DurationSigma"] >= 300)
+        data_["DurationSigma"] = 300;
+    if(data_["DurationSeed"] < 0)
+        data_["DurationSeed"] = 0;
+
+    if(logger_) {
+        logger_->debug("DurationDistribution: {} DurationMean: {} DurationSigma: {} DurationSeed: {} after normalizing",
+                       data_["DurationDistribution"], data_["DurationMean"], data_["DurationSigma"], data_["DurationSeed"]);
+    }
+}
+
 ThreadSafeConfig::ThreadSafeConfig(const std::filesystem::path &path, std::shared_ptr<spdlog::logger> logger) :
     IConfig(path, logger), logger_(logger)  {
     parser = std::make_shared<JsonParser>(logger);
@@ -162,43 +444,92 @@ ThreadSafeConfig::ThreadSafeConfig(const std::filesystem::path &path, std::share
         data_["SizeOfQueue"] = 15;
         notToUpdate = true;
     }
+    normalizeHttpSettings();
+    normalizeQueueType();
+    normalizeQueueDiscipline();
+    normalizePriorityClasses();
+    normalizeNumberFilter();
+    normalizeOperatorMode();
+    normalizeCdrSettings();
+    normalizeNodeID();
+    normalizeLogSettings();
+    normalizeDurationSettings();
+    publishSnapshot();
     stopThread = false;
     updated = false;
 }
 
 ThreadSafeConfig::~ThreadSafeConfig() {
-    stopThread = true;
-    if (updateThread.joinable()) {
-        updateThread.join();
-    }
+    stopMonitoring();
 }
 
 std::pair<int, int> ThreadSafeConfig::getMinMax() {
-    std::lock_guard<std::mutex> lock(configMutex);
-    if(logger_)
-        logger_->debug("Getting MinMax values (RMin: {}, RMax: {})", data_["RMin"], data_["RMax"]);
-    return std::make_pair(data_["RMin"], data_["RMax"]);
+    auto snapshot = snapshot_.load(std::memory_order_acquire);
+    return std::make_pair(snapshot->rMin, snapshot->rMax);
 }
 
 int ThreadSafeConfig::getAmountOfOperators() {
-    std::lock_guard<std::mutex> lock(configMutex);
-    if(logger_)
-        logger_->debug("Getting AmountOfOperators (AmountOfOperators: {})", data_["AmountOfOperators"]);
-    return data_["AmountOfOperators"];
+    return snapshot_.load(std::memory_order_acquire)->amountOfOperators;
 }
 
 int ThreadSafeConfig::getSizeOfQueue() {
-    std::lock_guard<std::mutex> lock(configMutex);
-    if(logger_)
-        logger_->debug("Getting SizeOfQueue (SizeOfQueue: {}) ", data_["SizeOfQueue"]);
-    return data_["SizeOfQueue"];
+    return snapshot_.load(std::memory_order_acquire)->sizeOfQueue;
+}
+
+int ThreadSafeConfig::getKeepAliveTimeout() {
+    return snapshot_.load(std::memory_order_acquire)->keepAliveTimeout;
+}
+
+int ThreadSafeConfig::getMaxRequestsPerConnection() {
+    return snapshot_.load(std::memory_order_acquire)->maxRequestsPerConnection;
+}
+
+int ThreadSafeConfig::getQueueType() {
+    return snapshot_.load(std::memory_order_acquire)->queueType;
+}
+
+int ThreadSafeConfig::getOperatorMode() {
+    return snapshot_.load(std::memory_order_acquire)->operatorMode;
+}
+
+int ThreadSafeConfig::getCdrDurability() {
+    return snapshot_.load(std::memory_order_acquire)->cdrDurability;
+}
+
+int ThreadSafeConfig::getCdrFlushInterval() {
+    return snapshot_.load(std::memory_order_acquire)->cdrFlushInterval;
+}
+
+int ThreadSafeConfig::getCdrBatchSize() {
+    return snapshot_.load(std::memory_order_acquire)->cdrBatchSize;
+}
+
+int ThreadSafeConfig::getNodeID() {
+    return snapshot_.load(std::memory_order_acquire)->nodeID;
+}
+
+int ThreadSafeConfig::getLogLevel() {
+    return snapshot_.load(std::memory_order_acquire)->logLevel;
+}
+
+int ThreadSafeConfig::getLogOverflowPolicy() {
+    return snapshot_.load(std::memory_order_acquire)->logOverflowPolicy;
 }
 
 std::filesystem::path ThreadSafeConfig::getPath() {
-    std::lock_guard<std::mutex> lock(configMutex);
+    return snapshot_.load(std::memory_order_acquire)->path;
+}
+
+std::shared_ptr<const ConfigSnapshot> ThreadSafeConfig::getSnapshot() {
+    return snapshot_.load(std::memory_order_acquire);
+}
+
+void ThreadSafeConfig::publishSnapshot() {
+    snapshot_.store(std::make_shared<const ConfigSnapshot>(ConfigSnapshot::fromData(data_, path_)),
+                    std::memory_order_release);
     if(logger_)
-        logger_->debug("Getting Path (Path: {})", path_.string());
-    return path_;
+        logger_->debug("Published configuration snapshot (RMin: {}, RMax: {}, AmountOfOperators: {}, SizeOfQueue: {})",
+                       data_["RMin"], data_["RMax"], data_["AmountOfOperators"], data_["SizeOfQueue"]);
 }
 
 void ThreadSafeConfig::updateConfig() {
@@ -229,10 +560,10 @@ bool ThreadSafeConfig::isUpdated() {
 }
 
 void ThreadSafeConfig::notify() {
-    if(manager) {
+    if(auto current = manager.lock()) {
         if(logger_)
             logger_->info("Notifying manager about configuration update");
-        manager->update();
+        current->update();
     } else {
         if(logger_)
             logger_->warn("Manager not set. Unable to notify about configuration update");
@@ -259,32 +590,89 @@ std::time_t lastTime(const std::filesystem::path &filePath) {
     return time;
 }
 
+void ThreadSafeConfig::reloadFromFile() {
+    if(logger_)
+        logger_->debug("Updating configuration after file change");
+    {
+        std::lock_guard<std::mutex> lock(configMutex);
+        updateConfig();
+    }
+    notify();
+    lastWriteTime = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+}
+
+#ifdef __linux__
 void ThreadSafeConfig::updateConfigThread() {
+    int inotifyFd = -1;
     try {
+        inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if(inotifyFd < 0)
+            throw std::system_error(errno, std::generic_category(), "inotify_init1");
 
-        lastWriteTime = lastTime(path_);
-        while (!stopThread) {
-            std::this_thread::sleep_for(std::chrono::seconds(60));
-            std::time_t currentWriteTime = lastTime(path_);
-
-            if (currentWriteTime > lastWriteTime) {
-                if(logger_)
-                    logger_->debug("Updating configuration from with regular checking");
-                {
-                    std::lock_guard<std::mutex> lock(configMutex);
-                    updateConfig();
+        // Следим за каталогом: при атомарной замене через rename у файла меняется inode,
+        // и наблюдение за самим файлом было бы потеряно.
+        const auto directory = path_.parent_path();
+        const auto fileName = path_.filename().string();
+        if(inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+            throw std::system_error(errno, std::generic_category(), "inotify_add_watch " + directory.string());
+        if(logger_)
+            logger_->info("Watching {} for configuration changes", path_.string());
+
+        alignas(inotify_event) char buffer[4096];
+        pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {wakeFd_, POLLIN, 0}};
+        bool pending = false;
+        while(!stopThread.load(std::memory_order_acquire)) {
+            int timeout = pending ? static_cast<int>(reloadDebounce.count()) : -1;
+            int rc = poll(fds, 2, timeout);
+            if(rc < 0) {
+                if(errno == EINTR)
+                    continue;
+                throw std::system_error(errno, std::generic_category(), "poll");
+            }
+            if(fds[1].revents & POLLIN)
+                break;
+            if(rc == 0) {
+                // Запись затихла на время reloadDebounce, файл можно перечитывать.
+                pending = false;
+                reloadFromFile();
+                continue;
+            }
+            ssize_t length;
+            while((length = read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+                for(char* ptr = buffer; ptr < buffer + length;) {
+                    auto* event = reinterpret_cast<inotify_event*>(ptr);
+                    if(event->len > 0 && fileName == event->name)
+                        pending = true;
+                    ptr += sizeof(inotify_event) + event->len;
                 }
-                notify();
-                lastWriteTime = currentWriteTime;
             }
         }
     } catch (std::exception& e) {
         if(logger_)
             logger_->critical("Critical error in updateConfigThread: {}", e.what());
-        else
-            throw e;
     }
+    if(inotifyFd >= 0)
+        close(inotifyFd);
 }
+#else
+void ThreadSafeConfig::updateConfigThread() {
+    try {
+        lastWriteTime = lastTime(path_);
+        std::unique_lock<std::mutex> lock(monitorMutex_);
+        while(!monitorCv_.wait_for(lock, std::chrono::seconds(1),
+                                   [this] { return stopThread.load(std::memory_order_acquire); })) {
+            if(lastTime(path_) > lastWriteTime) {
+                lock.unlock();
+                reloadFromFile();
+                lock.lock();
+            }
+        }
+    } catch (std::exception& e) {
+        if(logger_)
+            logger_->critical("Critical error in updateConfigThread: {}", e.what());
+    }
+}
+#endif
 
 void ThreadSafeConfig::updateWithRequest() {
     if(notToUpdate) {
@@ -308,9 +696,48 @@ void ThreadSafeConfig::RunMonitoring() {
     if(notToUpdate) {
         if(logger_)
             logger_->info("Could not run update thread because set flag not to update");
-    } else {
-        updateThread = std::thread(&ThreadSafeConfig::updateConfigThread, this);
+        return;
+    }
+    if(updateThread.joinable())
+        return;
+    stopThread = false;
+#ifdef __linux__
+    wakeFd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if(wakeFd_ < 0) {
+        if(logger_)
+            logger_->error("Could not create eventfd for configuration monitoring: {}", std::strerror(errno));
+        return;
     }
+#endif
+    updateThread = std::thread(&ThreadSafeConfig::updateConfigThread, this);
+}
+
+void ThreadSafeConfig::stopMonitoring() {
+    {
+        std::lock_guard<std::mutex> lock(monitorMutex_);
+        stopThread = true;
+    }
+    monitorCv_.notify_all();
+#ifdef __linux__
+    if(wakeFd_ >= 0) {
+        std::uint64_t one = 1;
+        [[maybe_unused]] auto written = write(wakeFd_, &one, sizeof(one));
+    }
+#endif
+    if(updateThread.joinable()) {
+        // Последняя ссылка на конфигурацию может освободиться в самом потоке мониторинга
+        // (через notify), тогда ждать его завершения нельзя.
+        if(updateThread.get_id() == std::this_thread::get_id())
+            updateThread.detach();
+        else
+            updateThread.join();
+    }
+#ifdef __linux__
+    if(wakeFd_ >= 0) {
+        close(wakeFd_);
+        wakeFd_ = -1;
+    }
+#endif
 }
 
 bool ThreadSafeConfig::isMonitoring() const {
@@ -331,6 +758,17 @@ void ThreadSafeConfig::normalizeData() {
     normalizeRMinRMax();
     normalizeAmountOfOperators();
     normalizeSizeOfQueue();
+    normalizeHttpSettings();
+    normalizeQueueType();
+    normalizeQueueDiscipline();
+    normalizePriorityClasses();
+    normalizeNumberFilter();
+    normalizeOperatorMode();
+    normalizeCdrSettings();
+    normalizeNodeID();
+    normalizeLogSettings();
+    normalizeDurationSettings();
+    publishSnapshot();
 }
 
 void ThreadSafeConfig::normalizeRMinRMax() {
@@ -357,8 +795,10 @@ void ThreadSafeConfig::normalizeRMinRMax() {
 void ThreadSafeConfig::normalizeAmountOfOperators() {
     if(logger_)
         logger_->info("Normalizing AmountOfOperators");
-    if(data_["AmountOfOperators"] >= 80)
-        data_["AmountOfOperators"] = 80;
+    // В режиме колеса таймеров операторы – логические слоты, а не потоки.
+    auto maxOperators = (data_["OperatorMode"] == 1) ? 100000 : 80;
+    if(data_["AmountOfOperators"] >= maxOperators)
+        data_["AmountOfOperators"] = maxOperators;
     if(data_["AmountOfOperators"] <= 2)
         data_["AmountOfOperators"] = 2;
 
@@ -380,4 +820,209 @@ void ThreadSafeConfig::normalizeSizeOfQueue() {
     if(logger_) {
         logger_->debug("SizeOfQueue: {} after normalizing", data_["SizeOfQueue"]);
     }
-}
\ No newline at end of file
+}
+
+void ThreadSafeConfig::normalizeHttpSettings() {
+    if(logger_)
+        logger_->info("Normalizing KeepAliveTimeout MaxRequestsPerConnection");
+
+    if(data_["KeepAliveTimeout"] <= 0)
+        data_["KeepAliveTimeout"] = 30;
+    if(data_["KeepAliveTimeout"] >= 3600)
+        data_["KeepAliveTimeout"] = 3600;
+    if(data_["MaxRequestsPerConnection"] <= 0)
+        data_["MaxRequestsPerConnection"] = 1000;
+    if(data_["MaxRequestsPerConnection"] >= 100000)
+        data_["MaxRequestsPerConnection"] = 100000;
+
+    if(logger_) {
+        logger_->debug("KeepAliveTimeout: {} MaxRequestsPerConnection: {} after normalizing",
+                       data_["KeepAliveTimeout"], data_["MaxRequestsPerConnection"]);
+    }
+}
+
+void ThreadSafeConfig::normalizeQueueType() {
+    if(logger_)
+        logger_->info("Normalizing QueueType");
+
+    if(data_["QueueType"] < 0 || data_["QueueType"] > 2)
+        data_["QueueType"] = 0;
+
+    if(logger_) {
+        logger_->debug("QueueType: {} after normalizing", data_["QueueType"]);
+    }
+}
+
+void ThreadSafeConfig::normalizeQueueDiscipline() {
+    if(logger_)
+        logger_->info("Normalizing QueueDiscipline CodelTarget CodelInterval");
+
+    if(data_["QueueDiscipline"] != 1)
+        data_["QueueDiscipline"] = 0;
+    if(data_["CodelTarget"] <= 0)
+        data_["CodelTarget"] = 5000;
+    if(data_["CodelTarget"] >= 600000)
+        data_["CodelTarget"] = 600000;
+    if(data_["CodelInterval"] <= 0)
+        data_["CodelInterval"] = 15000;
+    if(data_["CodelInterval"] >= 3600000)
+        data_["CodelInterval"] = 3600000;
+    // Интервал короче целевой задержки не дает очереди накопить задержку target до первого отбрасывания.
+    if(data_["CodelInterval"] < data_["CodelTarget"])
+        data_["CodelInterval"] = data_["CodelTarget"];
+
+    if(logger_) {
+        logger_->debug("QueueDiscipline: {} CodelTarget: {} CodelInterval: {} after normalizing",
+                       data_["QueueDiscipline"], data_["CodelTarget"], data_["CodelInterval"]);
+    }
+}
+
+void ThreadSafeConfig::normalizePriorityClasses() {
+    if(logger_)
+        logger_->info("Normalizing PriorityPrefixes PriorityWeightNormal PriorityWeightVip PriorityWeightEmergency");
+
+    const std::string prefixes = "PriorityPrefixes.";
+    for (auto it = data_.lower_bound(prefixes); it != data_.end() && it->first.starts_with(prefixes);) {
+        auto prefix = std::string_view{it->first}.substr(prefixes.size());
+        if (prefix.empty() || prefix.size() > utility::CallerNumber::maxLength ||
+            prefix.find_first_not_of("0123456789") != std::string_view::npos) {
+            if(logger_)
+                logger_->warn("Ignoring priority prefix {}: only digits up to {} characters are allowed",
+                              prefix, utility::CallerNumber::maxLength);
+            it = data_.erase(it);
+            continue;
+        }
+        it->second = std::clamp(it->second, 0, static_cast<int>(priorityClassCount) - 1);
+        ++it;
+    }
+
+    auto normalizeWeight = [this](const std::string& key, int byDefault) {
+        if(data_[key] <= 0)
+            data_[key] = byDefault;
+        if(data_[key] >= 1000)
+            data_[key] = 1000;
+    };
+    normalizeWeight("PriorityWeightNormal", 1);
+    normalizeWeight("PriorityWeightVip", 4);
+    normalizeWeight("PriorityWeightEmergency", 16);
+
+    if(logger_) {
+        logger_->debug("PriorityWeightNormal: {} PriorityWeightVip: {} PriorityWeightEmergency: {} after normalizing",
+                       data_["PriorityWeightNormal"], data_["PriorityWeightVip"], data_["PriorityWeightEmergency"]);
+    }
+}
+
+void ThreadSafeConfig::normalizeNumberFilter() {
+    if(logger_)
+        logger_->info("Normalizing NumberFilter NumberFilterMode");
+
+    const std::string prefixes = "NumberFilter.";
+    for (auto it = data_.lower_bound(prefixes); it != data_.end() && it->first.starts_with(prefixes);) {
+        auto prefix = std::string_view{it->first}.substr(prefixes.size());
+        if (prefix.empty() || prefix.size() > utility::CallerNumber::maxLength ||
+            prefix.find_first_not_of("0123456789") != std::string_view::npos) {
+            if(logger_)
+                logger_->warn("Ignoring number filter prefix {}: only digits up to {} characters are allowed",
+                              prefix, utility::CallerNumber::maxLength);
+            it = data_.erase(it);
+            continue;
+        }
+        if (it->second != 0)
+            it->second = 1;
+        ++it;
+    }
+
+    if(data_["NumberFilterMode"] != 1)
+        data_["NumberFilterMode"] = 0;
+
+    if(logger_) {
+        logger_->debug("NumberFilterMode: {} after normalizing", data_["NumberFilterMode"]);
+    }
+}
+
+void ThreadSafeConfig::normalizeOperatorMode() {
+    if(logger_)
+        logger_->info("Normalizing OperatorMode");
+
+    if(data_["OperatorMode"] != 1)
+        data_["OperatorMode"] = 0;
+
+    if(logger_) {
+        logger_->debug("OperatorMode: {} after normalizing", data_["OperatorMode"]);
+    }
+}
+
+void ThreadSafeConfig::normalizeCdrSettings() {
+    if(logger_)
+        logger_->info("Normalizing CdrDurability CdrFlushInterval CdrBatchSize");
+
+    if(data_["CdrDurability"] < 0 || data_["CdrDurability"] > 2)
+        data_["CdrDurability"] = 0;
+    if(data_["CdrFlushInterval"] <= 0)
+        data_["CdrFlushInterval"] = 50;
+    if(data_["CdrFlushInterval"] >= 10000)
+        data_["CdrFlushInterval"] = 10000;
+    if(data_["CdrBatchSize"] <= 0)
+        data_["CdrBatchSize"] = 65536;
+    if(data_["CdrBatchSize"] <= 4096)
+        data_["CdrBatchSize"] = 4096;
+    if(data_["CdrBatchSize"] >= 16777216)
+        data_["CdrBatchSize"] = 16777216;
+
+    if(logger_) {
+        logger_->debug("CdrDurability: {} CdrFlushInterval: {} CdrBatchSize: {} after normalizing",
+                       data_["CdrDurability"], data_["CdrFlushInterval"], data_["CdrBatchSize"]);
+    }
+}
+
+void ThreadSafeConfig::normalizeNodeID() {
+    if(logger_)
+        logger_->info("Normalizing NodeID");
+
+    if(data_["NodeID"] < 0 || data_["NodeID"] > 1023)
+        data_["NodeID"] = 0;
+
+    if(logger_) {
+        logger_->debug("NodeID: {} after normalizing", data_["NodeID"]);
+    }
+}
+
+void ThreadSafeConfig::normalizeLogSettings() {
+    if(logger_)
+        logger_->info("Normalizing LogLevel and LogOverflowPolicy");
+
+    // 0 - допустимый уровень trace, поэтому отсутствие ключа проверяется отдельно.
+    if(!data_.contains("LogLevel") || data_["LogLevel"] < 0 || data_["LogLevel"] > 6)
+        data_["LogLevel"] = 1;
+    if(data_["LogOverflowPolicy"] < 0 || data_["LogOverflowPolicy"] > 1)
+        data_["LogOverflowPolicy"] = 0;
+
+    if(logger_) {
+        logger_->debug("LogLevel: {} LogOverflowPolicy: {} after normalizing",
+                       data_["LogLevel"], data_["LogOverflowPolicy"]);
+    }
+}
+
+void ThreadSafeConfig::normalizeDurationSettings() {
+    if(logger_)
+        logger_->info("Normalizing DurationDistribution DurationMean DurationSigma DurationSeed");
+
+    if(data_["DurationDistribution"] < 0 || data_["DurationDistribution"] > 2)
+        data_["DurationDistribution"] = 0;
+    // 0 - среднее в середине [RMin, RMax], значения распределения все равно ограничиваются этим диапазоном.
+    if(data_["DurationMean"] < 0)
+        data_["DurationMean"] = 0;
+    if(data_["DurationMean"] >= 140)
+        data_["DurationMean"] = 140;
+    if(data_["DurationSigma"] <= 0)
+        data_["DurationSigma"] = 50;
+    if(data_["DurationSigma"] >= 300)
+        data_["DurationSigma"] = 300;
+    if(data_["DurationSeed"] < 0)
+        data_["DurationSeed"] = 0;
+
+    if(logger_) {
+        logger_->debug("DurationDistribution: {} DurationMean: {} DurationSigma: {} DurationSeed: {} after normalizing",
+                       data_["DurationDistribution"], data_["DurationMean"], data_["DurationSigma"], data_["DurationSeed"]);
+    }
+}
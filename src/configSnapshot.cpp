@@ -0,0 +1,61 @@
+#include "configSnapshot.hpp"
+
+/**
+ * @file configSnapshot.cpp
+ * @brief Содержит определение структуры ConfigSnapshot
+ */
+
+using namespace utility;
+
+ConfigSnapshot ConfigSnapshot::fromData(const std::map<std::string, int>& data, const std::filesystem::path& path) {
+    auto value = [&data](const std::string& key) {
+        auto it = data.find(key);
+        return it != data.end() ? it->second : 0;
+    };
+    ConfigSnapshot snapshot;
+    snapshot.rMin = value("RMin");
+    snapshot.rMax = value("RMax");
+    snapshot.amountOfOperators = value("AmountOfOperators");
+    snapshot.sizeOfQueue = value("SizeOfQueue");
+    snapshot.keepAliveTimeout = value("KeepAliveTimeout");
+    snapshot.maxRequestsPerConnection = value("MaxRequestsPerConnection");
+    snapshot.queueType = value("QueueType");
+    snapshot.queueDiscipline = value("QueueDiscipline");
+    snapshot.codelTarget = value("CodelTarget");
+    snapshot.codelInterval = value("CodelInterval");
+    snapshot.operatorMode = value("OperatorMode");
+    snapshot.cdrDurability = value("CdrDurability");
+    snapshot.cdrFlushInterval = value("CdrFlushInterval");
+    snapshot.cdrBatchSize = value("CdrBatchSize");
+    snapshot.nodeID = value("NodeID");
+    snapshot.logLevel = value("LogLevel");
+    snapshot.logOverflowPolicy = value("LogOverflowPolicy");
+    snapshot.durationDistribution = value("DurationDistribution");
+    snapshot.durationMean = value("DurationMean");
+    snapshot.durationSigma = value("DurationSigma");
+    snapshot.durationSeed = value("DurationSeed");
+    const std::string prefixes = "PriorityPrefixes.";
+    for (auto it = data.lower_bound(prefixes); it != data.end() && it->first.starts_with(prefixes); ++it)
+        snapshot.priorityPrefixes[it->first.substr(prefixes.size())] = it->second;
+    snapshot.priorityWeightNormal = value("PriorityWeightNormal");
+    snapshot.priorityWeightVip = value("PriorityWeightVip");
+    snapshot.priorityWeightEmergency = value("PriorityWeightEmergency");
+    snapshot.numberFilterMode = value("NumberFilterMode");
+    const std::string filter = "NumberFilter.";
+    auto it = data.lower_bound(filter);
+    if (snapshot.numberFilterMode == 1 || (it != data.end() && it->first.starts_with(filter))) {
+        auto trie = std::make_shared<PrefixTrie>();
+        // Корень дерева подходит любому номеру: белый список отклоняет, черный принимает.
+        trie->insert("", snapshot.numberFilterMode == 1 ? 0 : 1);
+        for (; it != data.end() && it->first.starts_with(filter); ++it)
+            trie->insert(std::string_view{it->first}.substr(filter.size()), it->second);
+        trie->compact();
+        snapshot.numberFilter = std::move(trie);
+    }
+    snapshot.path = path;
+    return snapshot;
+}
+
+bool ConfigSnapshot::rejects(std::string_view number) const {
+    return numberFilter && numberFilter->match(number) == 0;
+}
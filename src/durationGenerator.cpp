@@ -0,0 +1,103 @@
+#include "durationGenerator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <random>
+
+/**
+ * @file durationGenerator.cpp
+ * @brief Содержит определение класса DurationGenerator
+ */
+
+using namespace TP;
+
+namespace {
+constexpr std::uint64_t golden = 0x9E3779B97F4A7C15ull;
+
+std::uint64_t splitmix64(std::uint64_t value) {
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+/**
+ * @brief Генератор xoshiro256**, состояние заполняется из std::random_device через splitmix64.
+ */
+class Xoshiro256 {
+public:
+    Xoshiro256() {
+        std::random_device device;
+        auto seed = (std::uint64_t{device()} << 32) | device();
+        for (auto& word: state_) {
+            seed += golden;
+            word = splitmix64(seed);
+        }
+    }
+
+    std::uint64_t operator()() {
+        auto result = rotl(state_[1] * 5, 7) * 9;
+        auto t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+        return result;
+    }
+
+private:
+    static std::uint64_t rotl(std::uint64_t value, int shift) {
+        return (value << shift) | (value >> (64 - shift));
+    }
+
+    std::uint64_t state_[4];
+};
+}
+
+DurationGenerator::DurationGenerator(DurationDistribution distribution, int rMin, int rMax, int mean, double sigma,
+                                     std::uint64_t seed)
+    : distribution_(distribution), rMin_(std::min(rMin, rMax)), rMax_(std::max(rMin, rMax)),
+      mean_(mean > 0 ? mean : (rMin_ + rMax_) / 2.0), sigma_(sigma > 0 ? sigma : 0.5), seed_(seed) {
+}
+
+std::shared_ptr<const DurationGenerator> DurationGenerator::fromSnapshot(const utility::ConfigSnapshot& snapshot) {
+    return std::make_shared<const DurationGenerator>(
+            static_cast<DurationDistribution>(snapshot.durationDistribution), snapshot.rMin, snapshot.rMax,
+            snapshot.durationMean, snapshot.durationSigma / 100.0, static_cast<std::uint64_t>(snapshot.durationSeed));
+}
+
+std::chrono::seconds DurationGenerator::next() const {
+    double value;
+    switch (distribution_) {
+    case DurationDistribution::Exponential:
+        value = -mean_ * std::log1p(-nextUnit());
+        break;
+    case DurationDistribution::LogNormal: {
+        // Box-Muller, mu подобрано так, чтобы среднее распределения было равно mean_.
+        auto radius = std::sqrt(-2.0 * std::log1p(-nextUnit()));
+        auto normal = radius * std::cos(2.0 * std::numbers::pi * nextUnit());
+        value = std::exp(std::log(mean_) - sigma_ * sigma_ / 2.0 + sigma_ * normal);
+        break;
+    }
+    default:
+        return std::chrono::seconds{rMin_ + static_cast<int>(nextUnit() * (rMax_ - rMin_ + 1))};
+    }
+    return std::chrono::seconds{std::clamp(static_cast<int>(std::lround(std::min(value, double(rMax_)))), rMin_, rMax_)};
+}
+
+DurationDistribution DurationGenerator::distribution() const {
+    return distribution_;
+}
+
+std::uint64_t DurationGenerator::nextBits() const {
+    if (seed_ != 0)
+        return splitmix64(seed_ + golden * (sequence_.fetch_add(1, std::memory_order_relaxed) + 1));
+    thread_local Xoshiro256 generator;
+    return generator();
+}
+
+double DurationGenerator::nextUnit() const {
+    return static_cast<double>(nextBits() >> 11) * 0x1.0p-53;
+}
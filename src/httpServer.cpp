@@ -2,92 +2,302 @@
 
 /**
  * @file httpServer.cpp
- * @brief Содержит определение класса HttpServer
+ * @brief Содержит определение классов HttpServer и HttpSession
  */
 
 
 using namespace net;
 
-HttpServer::HttpServer(short unsigned port = 8080, std::filesystem::path path = "base.json"):
-    acceptor(io_context, {tcp::v4(), port}) {
+HttpSession::HttpSession(tcp::socket&& socket, HttpServer& server, HttpSettings settings):
+    stream_(std::move(socket)), idleTimer_(stream_.get_executor()), server_(server), settings_(settings) { }
+
+void HttpSession::start() {
+    asio::dispatch(stream_.get_executor(), beast::bind_front_handler(&HttpSession::maybeRead, shared_from_this()));
+}
+
+void HttpSession::maybeRead() {
+    if (reading_ || closing_ || pipeline_.size() >= pipelineLimit)
+        return;
+    doRead();
+}
+
+void HttpSession::doRead() {
+    reading_ = true;
+    incoming_ = std::make_shared<HttpExchange>();
+    if (pipeline_.empty())
+        armIdleTimer();
+    beast::http::async_read(stream_, buffer_, incoming_->request,
+                            beast::bind_front_handler(&HttpSession::onRead, shared_from_this()));
+}
+
+void HttpSession::onRead(beast::error_code ec, std::size_t) {
+    reading_ = false;
+    if (ec == beast::http::error::end_of_stream) {
+        closing_ = true;
+        if (pipeline_.empty() && !writing_)
+            doClose();
+        return;
+    }
+    if (ec == asio::error::operation_aborted)
+        return;
+    if (ec) {
+        if (server_.logger_)
+            SPDLOG_LOGGER_CRITICAL(server_.logger_, "Boost.Beast Error: {} , Code: {}", "read", ec.message());
+        return;
+    }
+
+    idleTimer_.cancel();
+    auto exchange = std::move(incoming_);
+    exchange->received = std::chrono::steady_clock::now();
+    ++requestsRead_;
+    if (!exchange->request.keep_alive() || requestsRead_ >= settings_.maxRequestsPerConnection)
+        closing_ = true;
+
+    if (exchange->request.method() != beast::http::verb::get) {
+        closing_ = true;
+        if (pipeline_.empty() && !writing_)
+            doClose();
+        return;
+    }
+
+    pipeline_.push_back(exchange);
+    try {
+        auto target = exchange->request.target();
+        server_.handleRequest(std::string_view{target.data(), target.size()}, shared_from_this(), exchange);
+    } catch (const std::exception& e) {
+        if (server_.logger_)
+            SPDLOG_LOGGER_CRITICAL(server_.logger_, "Error: {}", e.what());
+        exchange->response.result(beast::http::status::internal_server_error);
+        HttpServer::finalizeResponse(exchange->response);
+        complete(exchange);
+    }
+    maybeRead();
+}
+
+void HttpSession::complete(const std::shared_ptr<HttpExchange>& exchange) {
+    if (server_.metrics_)
+        server_.metrics_->recordHttpRequest(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - exchange->received));
+    exchange->ready = true;
+    doWrite();
+}
+
+void HttpSession::doWrite() {
+    if (writing_ || pipeline_.empty() || !pipeline_.front()->ready)
+        return;
+    writing_ = true;
+    auto& exchange = *pipeline_.front();
+    bool keepAlive = !(closing_ && pipeline_.size() == 1);
+    exchange.response.version(exchange.request.version());
+    exchange.response.keep_alive(keepAlive);
+    beast::http::async_write(stream_, exchange.response,
+                             beast::bind_front_handler(&HttpSession::onWrite, shared_from_this(), keepAlive));
+}
+
+void HttpSession::onWrite(bool keepAlive, beast::error_code ec, std::size_t) {
+    writing_ = false;
+    if (ec) {
+        if (server_.logger_)
+            SPDLOG_LOGGER_CRITICAL(server_.logger_, "Boost.Beast Error: {} , Code: {}", "write", ec.message());
+        return;
+    }
+    pipeline_.pop_front();
+    if (!keepAlive || (closing_ && pipeline_.empty()))
+        return doClose();
+
+    doWrite();
+    if (pipeline_.empty() && reading_)
+        armIdleTimer();
+    maybeRead();
+}
+
+void HttpSession::armIdleTimer() {
+    idleTimer_.expires_after(settings_.idleTimeout);
+    idleTimer_.async_wait(beast::bind_front_handler(&HttpSession::onIdleTimeout, shared_from_this()));
+}
+
+void HttpSession::onIdleTimeout(beast::error_code ec) {
+    if (ec || !pipeline_.empty() || writing_)
+        return;
+    if (server_.logger_)
+        SPDLOG_LOGGER_DEBUG(server_.logger_, "Closing idle connection after {} seconds", settings_.idleTimeout.count());
+    closing_ = true;
+    stream_.close();
+}
+
+void HttpSession::doClose() {
+    idleTimer_.cancel();
+    beast::error_code ec;
+    stream_.socket().shutdown(tcp::socket::shutdown_send, ec);
+}
+
+asio::any_io_executor HttpSession::executor() {
+    return stream_.get_executor();
+}
+
+HttpServer::HttpServer(short unsigned port = 8080, std::filesystem::path path = "base.json", unsigned ioThreads = 0):
+    acceptor(io_context, {tcp::v4(), port}), signals(io_context, SIGINT, SIGTERM),
+    ioThreads_(ioThreads ? ioThreads : std::max(1u, std::thread::hardware_concurrency())) {
     ManagerBuilder managerBuilder;
     manager = managerBuilder.Construct(path);
-    logger_ = managerBuilder.BuildLogger();
+    config_ = managerBuilder.GetConfig();
+    recorders_ = managerBuilder.BuildRecorders();
+    metrics_ = managerBuilder.GetMetrics();
+    callIdGenerator_ = managerBuilder.GetCallIdGenerator();
+    logger_ = managerBuilder.GetLogger();
     manager->startThreadPool();
 }
 
 void HttpServer::run() {
     try {
-        while (true) {
-            tcp::socket socket(io_context);
-            boost::system::error_code ec;
-            acceptor.accept(socket, ec);
-            if (ec) {
-                if (logger_)
-                    logger_->error("Error accepting connection: {}", ec.message());
-                break;
-            } else {
-                std::thread(&HttpServer::handleHttpRequest, this, std::move(socket)).detach();
-            }
-        }
+        signals.async_wait([this](const beast::error_code&, [[maybe_unused]] int signal) {
+            if (logger_)
+                SPDLOG_LOGGER_INFO(logger_, "Received signal {}, stopping server", signal);
+            stop();
+        });
+        doAccept();
 
+        std::vector<std::thread> threads;
+        threads.reserve(ioThreads_ - 1);
+        for (unsigned i = 1; i < ioThreads_; ++i)
+            threads.emplace_back([this] { io_context.run(); });
+        if (logger_)
+            SPDLOG_LOGGER_INFO(logger_, "Server is running with {} I/O threads", ioThreads_);
         io_context.run();
+
+        for (auto& thread: threads)
+            thread.join();
     } catch (const std::exception& e) {
         if (logger_)
-            logger_->critical("Error: {}", e.what());
+            SPDLOG_LOGGER_CRITICAL(logger_, "Error: {}", e.what());
     }
+    // Останавливаем мониторинг до освобождения менеджера, чтобы перезагрузка не пришлась на завершение.
+    config_->stopMonitoring();
+    for (const auto& recorder: recorders_)
+        recorder->flush();
 }
 
-void HttpServer::handleHttpRequest(tcp::socket socket) {
-    try {
-        beast::tcp_stream stream(std::move(socket));
-        beast::flat_buffer buffer;
-        beast::http::request<beast::http::string_body> req;
-        beast::http::read(stream, buffer, req);
-        beast::http::response<beast::http::string_body> res;
-
-        if (req.method() == beast::http::verb::get) {
-            handleRequest(static_cast<std::string>(req.target()), res);
-            beast::http::write(stream, res);
-        }
-    } catch (const beast::system_error& e) {
-        if (logger_)
-            logger_->critical("Boost.Beast Error: {} , Code: {}", e.what(), e.code().message());
-    } catch (const std::exception& e) {
+void HttpServer::stop() {
+    io_context.stop();
+}
+
+void HttpServer::doAccept() {
+    acceptor.async_accept(asio::make_strand(io_context), beast::bind_front_handler(&HttpServer::onAccept, this));
+}
+
+void HttpServer::onAccept(beast::error_code ec, tcp::socket socket) {
+    if (ec) {
         if (logger_)
-            logger_->critical("Error: {}", e.what());
+            SPDLOG_LOGGER_ERROR(logger_, "Error accepting connection: {}", ec.message());
+    } else {
+        std::make_shared<HttpSession>(std::move(socket), *this, httpSettings())->start();
     }
+    if (acceptor.is_open())
+        doAccept();
+}
+
+HttpSettings HttpServer::httpSettings() {
+    return HttpSettings{std::chrono::seconds{config_->getKeepAliveTimeout()},
+                        static_cast<std::size_t>(config_->getMaxRequestsPerConnection())};
+}
+
+void HttpServer::finalizeResponse(beast::http::response<beast::http::string_body>& res) {
+    res.version(11);
+    res.set(beast::http::field::server, "Boost.Beast HTTP Server");
+    res.prepare_payload();
 }
 
-void HttpServer::handleRequest(const std::string& path, beast::http::response<beast::http::string_body>& res) {
+void HttpServer::handleRequest(std::string_view path,
+                               const std::shared_ptr<HttpSession>& session,
+                               const std::shared_ptr<HttpExchange>& exchange) {
+    auto& res = exchange->response;
     if (path.find("/phone=") == 0) {
-        std::string phone = path.substr(7);
-        processPhoneCall(res, phone);
+        processPhoneCall(session, exchange, path.substr(7));
+        return;
     } else if (path.find("/update") == 0) {
         processUpdate(res);
+    } else if (path == "/metrics") {
+        processMetrics(res);
     } else {
         res.result(beast::http::status::not_found);
         res.body() = "Not Found";
     }
-    res.version(11);
-    res.set(beast::http::field::server, "Boost.Beast HTTP Server");
-    res.prepare_payload();
+    finalizeResponse(res);
+    session->complete(exchange);
 }
 
-void HttpServer::processPhoneCall(beast::http::response<beast::http::string_body>& res, std::string_view phone) {
+void HttpServer::processPhoneCall(const std::shared_ptr<HttpSession>& session,
+                                  const std::shared_ptr<HttpExchange>& exchange,
+                                  std::string_view phone) {
+    SPDLOG_LOGGER_DEBUG(logger_, "Thread id: {}, phone: {}", std::hash<std::thread::id>{}(std::this_thread::get_id()), phone);
+    if (!utility::CallerNumber::valid(phone)) {
+        auto& res = exchange->response;
+        res.result(beast::http::status::bad_request);
+        res.body() = "Invalid number";
+        finalizeResponse(res);
+        session->complete(exchange);
+        return;
+    }
+    auto snapshot = config_->getSnapshot();
+    auto limit = static_cast<std::size_t>(snapshot->sizeOfQueue) + static_cast<std::size_t>(snapshot->amountOfOperators);
+    if (!admission_.tryEnter(limit)) {
+        rejectOverloaded(session, exchange, phone);
+        return;
+    }
+    auto handler = [this, session, exchange](std::exception_ptr exception, Result result) {
+        admission_.leave();
+        asio::post(session->executor(), [this, session, exchange, exception, result]() {
+            auto& res = exchange->response;
+            if (exception) {
+                try {
+                    std::rethrow_exception(exception);
+                } catch (const std::exception& e) {
+                    if (logger_)
+                        SPDLOG_LOGGER_ERROR(logger_, "Call with CallID {} failed: {}", result.callID, e.what());
+                }
+                res.result(beast::http::status::internal_server_error);
+            } else {
+                fillCallResponse(res, result);
+            }
+            finalizeResponse(res);
+            session->complete(exchange);
+        });
+    };
     try {
-        logger_->debug("Thread id: {}, phone: {}", std::hash<std::thread::id>{}(std::this_thread::get_id()), phone);
-        auto [callID, future] = manager->addTask(phone);
+        manager->addTask(phone, std::move(handler));
+    } catch (...) {
+        admission_.leave();
+        throw;
+    }
+}
 
-        auto result = future.get();
-        auto seconds = std::chrono::duration_cast<std::chrono::seconds>(result.callDuration);
-        res.body() = "CallID: " + std::to_string(callID) + " call duration: " + std::to_string(seconds.count()) + "s";
+void HttpServer::rejectOverloaded(const std::shared_ptr<HttpSession>& session,
+                                  const std::shared_ptr<HttpExchange>& exchange,
+                                  std::string_view phone) {
+    CDR cdr;
+    cdr.startTime = cdr.operatorCallTime = cdr.endTime = std::chrono::system_clock::now();
+    cdr.callID = callIdGenerator_->next();
+    cdr.status = CallStatus::Overloaded;
+    cdr.operatorID = 0;
+    cdr.callDuration = std::chrono::seconds{0};
+    cdr.number = phone;
+    // Писатели CDR буферизуют запись, файл пишет поток-писатель.
+    for (const auto& recorder: recorders_)
+        recorder->makeRecord(cdr);
+    if (logger_)
+        SPDLOG_LOGGER_WARN(logger_, "{} calls in flight. Call with CallID {} rejected before queueing.",
+                           admission_.inFlight(), cdr.callID);
 
-        workWithCallStatus(res, result.status);
-    } catch (const std::future_error& e) {
-        if (logger_)
-            logger_->error("Caught a future_error: ", e.what());
-    }
+    auto& res = exchange->response;
+    fillCallResponse(res, Result{CallStatus::Overloaded, std::chrono::seconds{0}, cdr.callID});
+    finalizeResponse(res);
+    session->complete(exchange);
+}
+
+void HttpServer::fillCallResponse(beast::http::response<beast::http::string_body>& res, const Result& result) {
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(result.callDuration);
+    res.body() = "CallID: " + std::to_string(result.callID) + " call duration: " + std::to_string(seconds.count()) + "s";
+    workWithCallStatus(res, result.status);
 }
 
 void HttpServer::workWithCallStatus(beast::http::response<beast::http::string_body>& res, CallStatus status) {
@@ -130,4 +340,10 @@ void HttpServer::processUpdate(beast::http::response<beast::http::string_body>&
         res.result(beast::http::status::forbidden);
         res.body() = "Could not update";
     }
-}
\ No newline at end of file
+}
+
+void HttpServer::processMetrics(beast::http::response<beast::http::string_body>& res) {
+    res.result(beast::http::status::ok);
+    res.set(beast::http::field::content_type, "text/plain; version=0.0.4");
+    res.body() = metrics_ ? metrics_->prometheus() : std::string{};
+}
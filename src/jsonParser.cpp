@@ -49,7 +49,13 @@ std::map<std::string, int> JsonParser::outputConfig() {
         boost::property_tree::basic_ptree<std::string, std::string>::const_iterator iter = data_.begin(),
                                                                                     iterEnd = data_.end();
         for (; iter != iterEnd; ++iter) {
-            res[iter->first] = iter->second.get_value<int>();
+            if (iter->second.empty()) {
+                res[iter->first] = iter->second.get_value<int>();
+                continue;
+            }
+            // Вложенный объект разворачивается в ключи вида "Объект.ключ".
+            for (const auto& [key, child]: iter->second)
+                res[iter->first + "." + key] = child.get_value<int>();
         }
     } catch (std::exception& e) {
         if(logger_)
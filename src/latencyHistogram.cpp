@@ -0,0 +1,78 @@
+#include "latencyHistogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+/**
+ * @file latencyHistogram.cpp
+ * @brief Содержит определение класса LatencyHistogram
+ */
+
+using namespace utility;
+
+namespace {
+/// Номер шарда текущего потока, потоки получают шарды по кругу в порядке первой записи.
+std::size_t shardIndex() {
+    static std::atomic<std::size_t> nextShard{0};
+    thread_local std::size_t index = nextShard.fetch_add(1, std::memory_order_relaxed) % LatencyHistogram::shardCount;
+    return index;
+}
+}
+
+std::size_t LatencyHistogram::bucketIndex(std::uint64_t micros) {
+    if (micros < subBucketCount)
+        return static_cast<std::size_t>(micros);
+    unsigned shift = static_cast<unsigned>(std::bit_width(micros)) - subBucketBits - 1;
+    if (shift > maxShift)
+        return bucketCount - 1;
+    return subBucketCount * (shift + 1) + static_cast<std::size_t>((micros >> shift) - subBucketCount);
+}
+
+std::uint64_t LatencyHistogram::bucketUpperBound(std::size_t index) {
+    if (index < subBucketCount)
+        return index;
+    auto shift = index / subBucketCount - 1;
+    auto sub = index % subBucketCount;
+    return ((subBucketCount + sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(std::chrono::microseconds value) {
+    auto micros = static_cast<std::uint64_t>(std::max<std::chrono::microseconds::rep>(value.count(), 0));
+    auto& shard = shards_[shardIndex()];
+    shard.counts[bucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(micros, std::memory_order_relaxed);
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot result;
+    for (const auto& shard: shards_) {
+        for (std::size_t i = 0; i < bucketCount; ++i)
+            result.counts[i] += shard.counts[i].load(std::memory_order_relaxed);
+        result.sum += shard.sum.load(std::memory_order_relaxed);
+    }
+    for (auto count: result.counts)
+        result.count += count;
+    return result;
+}
+
+std::chrono::microseconds LatencyHistogram::Snapshot::percentile(double p) const {
+    if (count == 0)
+        return std::chrono::microseconds{0};
+    auto rank = static_cast<std::uint64_t>(std::ceil(std::clamp(p, 0.0, 100.0) / 100.0 * static_cast<double>(count)));
+    rank = std::max<std::uint64_t>(rank, 1);
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < bucketCount; ++i) {
+        seen += counts[i];
+        if (seen >= rank)
+            return std::chrono::microseconds{bucketUpperBound(i)};
+    }
+    return std::chrono::microseconds{bucketUpperBound(bucketCount - 1)};
+}
+
+std::uint64_t LatencyHistogram::Snapshot::countAtMost(std::uint64_t micros) const {
+    std::uint64_t result = 0;
+    for (std::size_t i = 0; i < bucketCount && bucketUpperBound(i) <= micros; ++i)
+        result += counts[i];
+    return result;
+}
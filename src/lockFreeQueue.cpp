@@ -0,0 +1,217 @@
+#include "lockFreeQueue.hpp"
+
+#include <stdexcept>
+
+/**
+ * @file lockFreeQueue.cpp
+ * @brief Содержит определение класса LockFreeQueue,
+ * который реализует интерфейс IQueue.
+ */
+
+using namespace TP;
+
+namespace {
+/// Минимальная емкость буфера, с запасом покрывает максимальный SizeOfQueue.
+constexpr std::size_t minCapacity = 1024;
+
+std::size_t roundUpToPowerOfTwo(std::size_t value) {
+    std::size_t result = 1;
+    while (result < value)
+        result <<= 1;
+    return result;
+}
+}
+
+LockFreeQueue::LockFreeQueue(int size) :
+    IQueue(size), sizeOfQueue(size) {
+    auto capacity = roundUpToPowerOfTwo(std::max<std::size_t>(2 * static_cast<std::size_t>(size), minCapacity));
+    buffer_ = std::make_unique<Cell[]>(capacity);
+    mask_ = capacity - 1;
+    for (std::size_t i = 0; i < capacity; ++i)
+        buffer_[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+std::pair<std::shared_ptr<ITask>, CallID>& LockFreeQueue::back() {
+    throw std::logic_error("LockFreeQueue does not support back()");
+}
+
+std::pair<std::shared_ptr<ITask>, CallID>& LockFreeQueue::front() {
+    throw std::logic_error("LockFreeQueue does not support front(), use tryPop()");
+}
+
+bool LockFreeQueue::empty() const {
+    return size_.load(std::memory_order_acquire) == 0;
+}
+
+bool LockFreeQueue::tryPop(std::pair<std::shared_ptr<ITask>, CallID>& taskPair, std::size_t) {
+    return tryPop(taskPair);
+}
+
+bool LockFreeQueue::isLockFree() const {
+    return true;
+}
+
+bool LockFreeQueue::enqueue(std::pair<std::shared_ptr<ITask>, CallID>& taskPair) {
+    auto pos = enqueuePos_.load(std::memory_order_relaxed);
+    for (;;) {
+        auto& cell = buffer_[pos & mask_];
+        auto sequence = cell.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.data = std::move(taskPair);
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool LockFreeQueue::dequeue(std::pair<std::shared_ptr<ITask>, CallID>& taskPair) {
+    auto pos = dequeuePos_.load(std::memory_order_relaxed);
+    for (;;) {
+        auto& cell = buffer_[pos & mask_];
+        auto sequence = cell.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1);
+        if (diff == 0) {
+            if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                taskPair = std::move(cell.data);
+                cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = dequeuePos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+LockFreeQueue::Shard& LockFreeQueue::shardFor(const utility::CallerNumber& number) {
+    return shards_[number.hash() % shardCount];
+}
+
+void LockFreeQueue::reject(const std::shared_ptr<ITask>& task, CallID callID, CallStatus status) {
+    task->cdr.status = status;
+    task->cdr.operatorID = 0;
+    task->cdr.callDuration = std::chrono::seconds{0};
+    task->cdr.endTime = task->cdr.operatorCallTime = std::chrono::system_clock::now();
+    writeCDR(task->cdr);
+
+    Result r;
+    r.callDuration = std::chrono::seconds{0};
+    r.callID = callID;
+    r.status = status;
+    task->complete(r);
+}
+
+bool LockFreeQueue::push(std::pair<std::shared_ptr<ITask>, CallID>&& taskPair) {
+    auto& task = taskPair.first;
+    auto callID = taskPair.second;
+    if (size_.fetch_add(1, std::memory_order_acq_rel) >= sizeOfQueue.load(std::memory_order_relaxed)) {
+        size_.fetch_sub(1, std::memory_order_acq_rel);
+        if (logger_)
+            SPDLOG_LOGGER_WARN(logger_, "Queue is overloaded. Max size {}. Task with CallID {} rejected.", sizeOfQueue.load(),
+                          callID);
+        reject(task, callID, CallStatus::Overloaded);
+        return false;
+    }
+
+    // Задача попадает в индекс раньше, чем в буфер: иначе извлекающий поток
+    // может принять ее за замененный дубликат.
+    auto& shard = shardFor(task->getNumber());
+    std::shared_ptr<ITask> duplicate;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.tasks.find(task->getNumber());
+        if (it != shard.tasks.end()) {
+            duplicate = std::move(it->second);
+            shard.tasks.erase(it);
+        }
+        shard.tasks.emplace(task->getNumber(), task);
+    }
+
+    if (duplicate) {
+        size_.fetch_sub(1, std::memory_order_acq_rel);
+        if (logger_)
+            SPDLOG_LOGGER_WARN(logger_, "Duplicate task with CallID {}. Removed from the queue.", duplicate->cdr.callID);
+        reject(duplicate, duplicate->cdr.callID, CallStatus::Duplication);
+    }
+
+    auto keep = task;
+    if (!enqueue(taskPair)) {
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.tasks.find(keep->getNumber());
+            if (it != shard.tasks.end() && it->second == keep)
+                shard.tasks.erase(it);
+        }
+        size_.fetch_sub(1, std::memory_order_acq_rel);
+        if (logger_)
+            SPDLOG_LOGGER_WARN(logger_, "Queue storage is exhausted. Task with CallID {} rejected.", callID);
+        reject(keep, callID, CallStatus::Overloaded);
+        return false;
+    }
+
+    if (logger_)
+        SPDLOG_LOGGER_INFO(logger_, "Task with CallID {}. Was added to the queue", callID);
+    return true;
+}
+
+bool LockFreeQueue::tryPop(std::pair<std::shared_ptr<ITask>, CallID>& taskPair) {
+    while (dequeue(taskPair)) {
+        auto& shard = shardFor(taskPair.first->getNumber());
+        std::unique_lock<std::mutex> lock(shard.mutex);
+        auto it = shard.tasks.find(taskPair.first->getNumber());
+        if (it != shard.tasks.end() && it->second == taskPair.first) {
+            shard.tasks.erase(it);
+            lock.unlock();
+            size_.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+        // Задача была заменена дубликатом и уже завершена.
+    }
+    return false;
+}
+
+void LockFreeQueue::pop() {
+    std::pair<std::shared_ptr<ITask>, CallID> taskPair;
+    tryPop(taskPair);
+}
+
+void LockFreeQueue::update(int size) {
+    auto capacity = (mask_ + 1) / 2;
+    auto newSize = std::min<std::size_t>(size, capacity);
+    if (logger_) {
+        SPDLOG_LOGGER_INFO(logger_, "Queue size updated to {}", newSize);
+        if (newSize != static_cast<std::size_t>(size))
+            SPDLOG_LOGGER_WARN(logger_, "Requested queue size {} exceeds lock-free queue capacity {}", size, capacity);
+    }
+    sizeOfQueue.store(newSize, std::memory_order_relaxed);
+}
+
+void LockFreeQueue::setLogger(std::shared_ptr<spdlog::logger> logger) {
+    this->logger_ = logger;
+}
+
+void LockFreeQueue::setRecorders(std::vector<std::shared_ptr<IRecorder>> recorders) {
+    recorders_ = recorders;
+}
+
+void LockFreeQueue::writeCDR(const CDR& cdr) {
+    std::lock_guard<std::mutex> lock(cdrMutex_);
+    for (const auto& recorder: recorders_)
+        recorder->makeRecord(cdr);
+}
+
+std::size_t LockFreeQueue::expire([[maybe_unused]] std::chrono::system_clock::time_point now) {
+    return 0;
+}
+
+std::chrono::system_clock::time_point LockFreeQueue::nextDeadline() const {
+    return std::chrono::system_clock::time_point::max();
+}
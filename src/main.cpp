@@ -4,18 +4,24 @@ int main(int argc, const char* argv[]) {
     spdlog::init_thread_pool(8192, 1);
     short unsigned port = 8080;
     std::filesystem::path pathToFile = "base.json";
+    unsigned ioThreads = 0;
     if(argc == 2) {
         if(!strcmp(argv[1], "test")) {
             std::cout << "Normal test run!" << std::endl;
             return 0;
         }
     }
-    if(argc == 3) {
+    if(argc >= 3) {
         port = std::stoi(std::string{argv[1]});
         pathToFile = argv[2];
     }
-    net::HttpServer server(port, pathToFile);
-    server.run();
+    if(argc >= 4)
+        ioThreads = std::stoul(std::string{argv[3]});
+    {
+        // Сервер разрушается до spdlog::shutdown: менеджер и пул пишут в лог при остановке.
+        net::HttpServer server(port, pathToFile, ioThreads);
+        server.run();
+    }
 
     spdlog::shutdown();
     return 0;
@@ -12,45 +12,91 @@
 
 Manager::Manager(std::shared_ptr<utility::IConfig> conf, std::shared_ptr<TP::IThreadPool> pool)  :
     IManager(conf, pool), config_(conf), threadPool_(pool) {
-    std::tie(RMin_, RMax_) = config_->getMinMax();
+    auto snapshot = config_->getSnapshot();
+    snapshot_.store(snapshot, std::memory_order_release);
+    durationGenerator_.store(TP::DurationGenerator::fromSnapshot(*snapshot), std::memory_order_release);
 }
 
 
 std::pair<TP::CallID, std::future<Result>> Manager::addTask(std::string_view number) {
+    auto snapshot = snapshot_.load(std::memory_order_acquire);
+    auto task = makeTask(number, *snapshot);
+    task->addPromise(taskPool_.makePromise());
     std::shared_lock<std::shared_mutex> lc(updateMtx);
+    if (snapshot->rejects(number)) {
+        auto future = task->promise_->get_future();
+        auto callID = rejectTask(std::move(task));
+        return std::make_pair(callID, std::move(future));
+    }
+    return threadPool_->add_task(std::move(task));
+}
+
+TP::CallID Manager::addTask(std::string_view number, TP::CompletionHandler handler) {
+    auto snapshot = snapshot_.load(std::memory_order_acquire);
+    auto task = makeTask(number, *snapshot);
+    std::shared_lock<std::shared_mutex> lc(updateMtx);
+    if (snapshot->rejects(number)) {
+        task->addCompletionHandler(std::move(handler));
+        return rejectTask(std::move(task));
+    }
+    return threadPool_->add_task(std::move(task), std::move(handler));
+}
+
+TP::CallID Manager::rejectTask(std::shared_ptr<TP::ITask> task) {
+    // Номер запрещен фильтром: вызов не занимает место в очереди и сразу получает ответ.
+    auto callID = threadPool_->reject(std::move(task), CallStatus::Rejected);
+    if (logger_)
+        SPDLOG_LOGGER_INFO(logger_, "Call with CallID {} rejected by number filter", callID);
+    return callID;
+}
+
+std::shared_ptr<TP::ITask> Manager::makeTask(std::string_view number, const utility::ConfigSnapshot& snapshot) {
     auto now = std::chrono::system_clock::now();
 
     if (logger_) {
-        logger_->debug("Create task with number: " + std::string{number} + " with RMin_ " + std::to_string(RMin_) +
-                       " RMax_ " + std::to_string(RMax_));
+        SPDLOG_LOGGER_DEBUG(logger_, "Create task with number: {} with RMin {} RMax {}", number, snapshot.rMin, snapshot.rMax);
     }
 
-    auto task = std::make_shared<TP::Task>(RMin_, RMax_, number, now, logger_);
-    return threadPool_->add_task(task);
+    auto task = taskPool_.makeTask(snapshot.rMin, snapshot.rMax, number, now, logger_);
+    task->setDurationGenerator(durationGenerator_.load(std::memory_order_acquire));
+    return task;
 }
 
 
 void Manager::update() {
-    std::unique_lock<std::shared_mutex> lc(updateMtx);
-    std::tie(this->RMin_, this->RMax_) = config_->getMinMax();
+    auto snapshot = config_->getSnapshot();
+    snapshot_.store(snapshot, std::memory_order_release);
+    durationGenerator_.store(TP::DurationGenerator::fromSnapshot(*snapshot), std::memory_order_release);
+    if(logger_) {
+        // Логгер общий для всех компонентов, поэтому новый уровень применяется сразу ко всем.
+        logger_->set_level(static_cast<spdlog::level::level_enum>(snapshot->logLevel));
+        SPDLOG_LOGGER_DEBUG(logger_, "Debug message for update: New RMin {} RMax {}", snapshot->rMin, snapshot->rMax);
+        if (snapshot->numberFilter)
+            SPDLOG_LOGGER_INFO(logger_, "Number filter {} with {} prefixes",
+                               snapshot->numberFilterMode == 1 ? "whitelist" : "blacklist",
+                               snapshot->numberFilter->size() - 1);
+    }
 
-    if(logger_)
-        logger_->debug("Debug message for update: New RMin_ " + std::to_string(RMin_) + " RMax_ " + std::to_string(RMax_));
-
-    threadPool_->task_queue->update(config_->getSizeOfQueue());
-    if(static_cast<std::size_t>(config_->getAmountOfOperators()) != threadPool_->getSize()) {
-        auto newThreadPool = std::make_shared<TP::ThreadPool>(config_->getAmountOfOperators(),
-                                                              config_->getSizeOfQueue());
-        newThreadPool->setLogger(logger_);
-        setNewThreadPool(newThreadPool);
+    {
+        std::unique_lock<std::shared_mutex> lc(updateMtx);
+        threadPool_->task_queue->update(snapshot->sizeOfQueue);
+    }
+
+    // Пул меняет количество операторов на месте, поэтому добавление задач не приостанавливается.
+    std::shared_lock<std::shared_mutex> lc(updateMtx);
+    auto amountOfOperators = static_cast<unsigned>(snapshot->amountOfOperators);
+    if(amountOfOperators != threadPool_->getSize()) {
+        if(logger_)
+            SPDLOG_LOGGER_INFO(logger_, "Resizing thread pool from {} to {} operators", threadPool_->getSize(), amountOfOperators);
+        threadPool_->resize(amountOfOperators);
     }
     if(logger_)
-        logger_->info("All was updated");
+        SPDLOG_LOGGER_INFO(logger_, "All was updated");
 }
 
 bool Manager::processRequestForUpdate() {
     if(logger_)
-        logger_->debug("Processing request for update");
+        SPDLOG_LOGGER_DEBUG(logger_, "Processing request for update");
     config_->updateWithRequest();
     return config_->isUpdated();
 }
@@ -58,8 +104,8 @@ bool Manager::processRequestForUpdate() {
 void Manager::setNewConfig(std::shared_ptr<utility::IConfig> config) {
     config_ = config;
     if (logger_) {
-        logger_->debug("New configuration set");
-        logger_->debug("Updating configuration");
+        SPDLOG_LOGGER_DEBUG(logger_, "New configuration set");
+        SPDLOG_LOGGER_DEBUG(logger_, "Updating configuration");
     }
     update();
 }
@@ -70,21 +116,21 @@ void Manager::setNewThreadPool(std::shared_ptr<TP::IThreadPool> pool) {
     this->threadPool_ = pool;
     startThreadPool();
     if(logger_)
-        logger_->debug("New thread pool set");
+        SPDLOG_LOGGER_DEBUG(logger_, "New thread pool set");
 }
 
 void Manager::startThreadPool() {
     threadPool_->start();
     if(logger_)
-        logger_->info("Thread pool started");
+        SPDLOG_LOGGER_INFO(logger_, "Thread pool started");
 }
 
 void Manager::stopThreadPool() {
     threadPool_->stop();
     if(logger_)
-        logger_->info("Thread pool stopped");
+        SPDLOG_LOGGER_INFO(logger_, "Thread pool stopped");
 }
 void Manager::setLogger(std::shared_ptr<spdlog::logger> logger) {
     this->logger_ = logger;
-    logger_->info("Logger set for Manager");
+    SPDLOG_LOGGER_INFO(logger_, "Logger set for Manager");
 }
@@ -0,0 +1,102 @@
+#include "prefixTrie.hpp"
+
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @file prefixTrie.cpp
+ * @brief Содержит определение класса PrefixTrie
+ */
+
+using namespace utility;
+
+PrefixTrie::PrefixTrie() : nodes_(1) {
+}
+
+void PrefixTrie::insert(std::string_view prefix, int value) {
+    if (!packed_.empty())
+        throw std::logic_error("Prefix trie is already compacted");
+    if (value < 0)
+        throw std::invalid_argument("Negative value for prefix " + std::string{prefix});
+    std::uint32_t node = 0;
+    for (auto symbol: prefix) {
+        if (symbol < '0' || symbol > '9')
+            throw std::invalid_argument("Prefix contains a non-digit: " + std::string{prefix});
+        auto digit = static_cast<std::size_t>(symbol - '0');
+        if (nodes_[node].children[digit] == 0) {
+            nodes_[node].children[digit] = static_cast<std::uint32_t>(nodes_.size());
+            nodes_.emplace_back();
+        }
+        node = nodes_[node].children[digit];
+    }
+    if (nodes_[node].value == none)
+        ++size_;
+    nodes_[node].value = value;
+}
+
+void PrefixTrie::compact() {
+    if (!packed_.empty())
+        return;
+    // Обход в ширину: потомки каждого узла получают соседние индексы.
+    std::vector<std::uint32_t> order{0};
+    order.reserve(nodes_.size());
+    packed_.resize(nodes_.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        const auto& node = nodes_[order[i]];
+        auto& packed = packed_[i];
+        packed.value = node.value;
+        packed.first = static_cast<std::uint32_t>(order.size());
+        for (std::size_t digit = 0; digit < node.children.size(); ++digit) {
+            if (node.children[digit] == 0)
+                continue;
+            packed.mask |= static_cast<std::uint16_t>(1u << digit);
+            order.push_back(node.children[digit]);
+        }
+    }
+    nodes_ = {};
+}
+
+int PrefixTrie::match(std::string_view number) const {
+    if (!packed_.empty())
+        return matchPacked(number);
+    auto result = nodes_[0].value;
+    std::uint32_t node = 0;
+    for (auto symbol: number) {
+        auto digit = static_cast<unsigned>(symbol - '0');
+        if (digit > 9)
+            break;
+        node = nodes_[node].children[digit];
+        if (node == 0)
+            break;
+        if (nodes_[node].value != none)
+            result = nodes_[node].value;
+    }
+    return result;
+}
+
+int PrefixTrie::matchPacked(std::string_view number) const {
+    auto result = packed_[0].value;
+    std::uint32_t node = 0;
+    for (auto symbol: number) {
+        auto digit = static_cast<unsigned>(symbol - '0');
+        if (digit > 9)
+            break;
+        auto bit = 1u << digit;
+        unsigned mask = packed_[node].mask;
+        if ((mask & bit) == 0)
+            break;
+        node = packed_[node].first + static_cast<std::uint32_t>(std::popcount(mask & (bit - 1)));
+        if (packed_[node].value != none)
+            result = packed_[node].value;
+    }
+    return result;
+}
+
+std::size_t PrefixTrie::size() const {
+    return size_;
+}
+
+bool PrefixTrie::empty() const {
+    return size_ == 0;
+}
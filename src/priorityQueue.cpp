@@ -0,0 +1,189 @@
+#include "priorityQueue.hpp"
+
+#include <algorithm>
+
+/**
+ * @file priorityQueue.cpp
+ * @brief Содержит определение класса PriorityQueue,
+ * который реализует интерфейс IQueue.
+ */
+
+using namespace TP;
+
+PriorityQueue::PriorityQueue(int size, std::shared_ptr<const utility::PrefixTrie> rules,
+                             std::array<unsigned, priorityClassCount> weights) :
+    IQueue(size), weights_(weights), sizeOfQueue_(size), rules_(std::move(rules)) {
+    for (auto& queue: classes_)
+        queue = std::make_unique<Queue>(size);
+    for (auto& weight: weights_)
+        weight = std::max(weight, 1u);
+}
+
+std::pair<std::shared_ptr<ITask>, CallID>& PriorityQueue::back() {
+    return classes_[last_]->back();
+}
+
+std::pair<std::shared_ptr<ITask>, CallID>& PriorityQueue::front() {
+    auto index = nextClass();
+    return classes_[index == npos ? current_ : index]->front();
+}
+
+bool PriorityQueue::empty() const {
+    return std::all_of(classes_.begin(), classes_.end(), [](const auto& queue) { return queue->empty(); });
+}
+
+PriorityClass PriorityQueue::classify(const utility::CallerNumber& number) const {
+    auto value = rules_ ? rules_->match(number.view()) : utility::PrefixTrie::none;
+    if (value == utility::PrefixTrie::none)
+        return PriorityClass::Normal;
+    return static_cast<PriorityClass>(std::min<std::size_t>(value, priorityClassCount - 1));
+}
+
+bool PriorityQueue::push(std::pair<std::shared_ptr<ITask>, CallID>&& taskPair) {
+    auto priority = classify(taskPair.first->getNumber());
+    taskPair.first->cdr.priority = priority;
+
+    std::size_t total = 0;
+    for (const auto& queue: classes_)
+        total += queue->size();
+    if (total >= sizeOfQueue_) {
+        handleOverloadedTask(taskPair);
+        return false;
+    }
+
+    auto index = static_cast<std::size_t>(priority);
+    if (logger_)
+        SPDLOG_LOGGER_DEBUG(logger_, "Task with CallID {} goes to priority class {}", taskPair.second, index);
+    auto pushed = classes_[index]->push(std::move(taskPair));
+    last_ = index;
+    refreshDepth(index);
+    return pushed;
+}
+
+void PriorityQueue::pop() {
+    auto index = nextClass();
+    if (index == npos)
+        return;
+    classes_[index]->pop();
+    refreshDepth(index);
+    charge(index);
+}
+
+bool PriorityQueue::tryPop(std::pair<std::shared_ptr<ITask>, CallID>& taskPair) {
+    for (auto index = nextClass(); index != npos; index = nextClass()) {
+        auto popped = classes_[index]->tryPop(taskPair);
+        refreshDepth(index);
+        if (popped) {
+            charge(index);
+            return true;
+        }
+        // Очередь класса опустела: CoDel или истекшие сроки забрали оставшиеся вызовы.
+    }
+    return false;
+}
+
+bool PriorityQueue::tryPop(std::pair<std::shared_ptr<ITask>, CallID>& taskPair, [[maybe_unused]] std::size_t worker) {
+    return tryPop(taskPair);
+}
+
+std::size_t PriorityQueue::nextClass() {
+    for (std::size_t i = 0; i < priorityClassCount; ++i) {
+        if (!classes_[current_]->empty()) {
+            if (deficit_[current_] == 0)
+                deficit_[current_] = weights_[current_];
+            return current_;
+        }
+        // Пустой класс теряет остаток хода, как в deficit round robin.
+        deficit_[current_] = 0;
+        advance();
+    }
+    return npos;
+}
+
+void PriorityQueue::charge(std::size_t index) {
+    if (--deficit_[index] == 0)
+        advance();
+}
+
+void PriorityQueue::advance() {
+    current_ = (current_ + priorityClassCount - 1) % priorityClassCount;
+}
+
+void PriorityQueue::refreshDepth(std::size_t index) {
+    depth_[index].store(classes_[index]->size(), std::memory_order_relaxed);
+}
+
+std::size_t PriorityQueue::depth(PriorityClass priority) const {
+    return depth_[static_cast<std::size_t>(priority)].load(std::memory_order_relaxed);
+}
+
+void PriorityQueue::handleOverloadedTask(const std::pair<std::shared_ptr<ITask>, CallID>& taskPair) {
+    auto task = taskPair.first;
+    task->cdr.status = CallStatus::Overloaded;
+    task->cdr.operatorID = 0;
+    task->cdr.callDuration = std::chrono::seconds{0};
+    task->cdr.endTime = task->cdr.operatorCallTime = std::chrono::system_clock::now();
+    writeCDR(task->cdr);
+
+    Result r;
+    r.callDuration = std::chrono::seconds{0};
+    r.callID = taskPair.second;
+    r.status = CallStatus::Overloaded;
+
+    if (logger_)
+        SPDLOG_LOGGER_WARN(logger_, "Queue is overloaded. Max size {}. Task with CallID {} rejected.",
+                           sizeOfQueue_, r.callID);
+
+    task->complete(r);
+}
+
+bool PriorityQueue::isLockFree() const {
+    return false;
+}
+
+void PriorityQueue::update(int size) {
+    sizeOfQueue_ = size;
+    for (auto& queue: classes_)
+        queue->update(size);
+    if (logger_)
+        SPDLOG_LOGGER_INFO(logger_, "Priority queue size updated to {}", size);
+}
+
+std::size_t PriorityQueue::expire(std::chrono::system_clock::time_point now) {
+    std::size_t expired = 0;
+    for (std::size_t index = 0; index < priorityClassCount; ++index) {
+        expired += classes_[index]->expire(now);
+        refreshDepth(index);
+    }
+    return expired;
+}
+
+std::chrono::system_clock::time_point PriorityQueue::nextDeadline() const {
+    auto deadline = std::chrono::system_clock::time_point::max();
+    for (const auto& queue: classes_)
+        deadline = std::min(deadline, queue->nextDeadline());
+    return deadline;
+}
+
+void PriorityQueue::setCodel(std::chrono::milliseconds target, std::chrono::milliseconds interval) {
+    for (auto& queue: classes_)
+        queue->setCodel(target, interval);
+}
+
+void PriorityQueue::setLogger(std::shared_ptr<spdlog::logger> logger) {
+    logger_ = logger;
+    for (auto& queue: classes_)
+        queue->setLogger(logger);
+}
+
+void PriorityQueue::setRecorders(std::vector<std::shared_ptr<IRecorder>> recorders) {
+    for (auto& queue: classes_)
+        queue->setRecorders(recorders);
+    recorders_ = std::move(recorders);
+}
+
+void PriorityQueue::writeCDR(const CDR& cdr) {
+    std::lock_guard<std::mutex> lock(cdrMutex_);
+    for (const auto& recorder: recorders_)
+        recorder->makeRecord(cdr);
+}
@@ -1,5 +1,7 @@
 #include "queue.hpp"
 
+#include <cmath>
+
 /**
  * @file queue.hpp
  * @brief Содержит определение класса Queue,
@@ -8,78 +10,193 @@
 
 using namespace TP;
 
+namespace {
+/**
+ * @brief Округляет значение до ближайшей сверху степени двойки.
+ * @param value Значение.
+ * @return Степень двойки не меньше value.
+ */
+std::size_t roundUpToPowerOfTwo(std::size_t value) {
+    std::size_t result = 1;
+    while (result < value)
+        result <<= 1;
+    return result;
+}
+}
+
 Queue::Queue(int size) :
     IQueue(size), sizeOfQueue(size) {
-    queue_.reserve(size);
+    rebuild(roundUpToPowerOfTwo(std::max<std::size_t>(2 * sizeOfQueue, 2)));
+}
+
+std::pair<std::shared_ptr<ITask>, CallID>& Queue::slot(std::size_t position) {
+    return ring_[position & (ring_.size() - 1)];
 }
 
 std::pair<std::shared_ptr<ITask>, CallID>& Queue::back() {
     if(logger_)
-        logger_->debug("Accessing the back of the queue");
-    return queue_.back();
+        SPDLOG_LOGGER_DEBUG(logger_, "Accessing the back of the queue");
+    return slot(tail_ - 1);
 }
 
 std::pair<std::shared_ptr<ITask>, CallID>& Queue::front() {
     if(logger_)
-        logger_->debug("Accessing the front of the queue");
-    return queue_.front();
+        SPDLOG_LOGGER_DEBUG(logger_, "Accessing the front of the queue");
+    return slot(head_);
 }
 
 bool Queue::empty() const {
     if(logger_)
-        logger_->debug("Checking if the queue is empty");
-    return queue_.empty();
+        SPDLOG_LOGGER_DEBUG(logger_, "Checking if the queue is empty");
+    return size_ == 0;
+}
+
+std::size_t Queue::size() const {
+    return size_;
 }
 
 void Queue::handleOverloadedTask(const std::pair<std::shared_ptr<ITask>, CallID>& taskPair) {
     Result r;
     auto task = taskPair.first;  // Shared ownership
-    processCDR(task, false);
+    processCDR(task, CallStatus::Overloaded);
 
     r.callDuration = std::chrono::seconds{0};
     r.callID = taskPair.second;
     r.status = CallStatus::Overloaded;
 
     if (logger_)
-        logger_->warn("Queue is overloaded. Current queue size: {} while max size {}. Task with CallID {} rejected.",
-                      queue_.size(), sizeOfQueue, r.callID);
+        SPDLOG_LOGGER_WARN(logger_, "Queue is overloaded. Current queue size: {} while max size {}. Task with CallID {} rejected.",
+                      size_, sizeOfQueue, r.callID);
 
-    task->promise_->set_value(r);
+    task->complete(r);
 }
 
 void Queue::handleTask(std::pair<std::shared_ptr<ITask>, CallID>& taskPair) {
-    auto it = std::find_if(queue_.begin(), queue_.end(),
-                           [taskNumber = taskPair.first->getNumber()](const auto& queuedTask) {
-                               return queuedTask.first->getNumber() == taskNumber;
-                           });
+    const auto& number = taskPair.first->getNumber();
+    auto hash = number.hash();
+    auto found = findIndex(number, hash);
 
-    if (it != queue_.end()) {
+    if (found != npos) {
+        auto& duplicate = slot(index_[found].position);
         Result r;
-        auto task = it->first;
-        processCDR(task, true);
+        auto task = std::move(duplicate.first);
+        processCDR(task, CallStatus::Duplication);
 
         r.callDuration = std::chrono::seconds{0};
-        r.callID = it->second;
+        r.callID = duplicate.second;
         r.status = CallStatus::Duplication;
 
-        task->promise_->set_value(r);
-        queue_.erase(it);
+        task->complete(r);
+        eraseDeadline(index_[found].position);
+        eraseIndex(found);
+        --size_;
+        trim();
 
         if (logger_)
-            logger_->warn("Duplicate task with CallID {}. Removed from the queue.", r.callID);
+            SPDLOG_LOGGER_WARN(logger_, "Duplicate task with CallID {}. Removed from the queue.", r.callID);
     }
 
     if (logger_)
-        logger_->info("Task with CallID {}. Was added to the queue", taskPair.second);
+        SPDLOG_LOGGER_INFO(logger_, "Task with CallID {}. Was added to the queue", taskPair.second);
+
+    if (tail_ - head_ == ring_.size())
+        rebuild(ring_.size());
 
-    queue_.emplace_back(std::move(taskPair));
+    insertIndex(tail_, hash);
+    insertDeadline(tail_, taskPair.first->getDeadline());
+    hashes_[tail_ & (ring_.size() - 1)] = hash;
+    enqueued_[tail_ & (ring_.size() - 1)] = Clock::now();
+    slot(tail_++) = std::move(taskPair);
+    ++size_;
 
     if (logger_)
-        logger_->info("Current queue size {}", queue_.size());
+        SPDLOG_LOGGER_INFO(logger_, "Current queue size {}", size_);
 }
 
-void Queue::processCDR(std::shared_ptr<ITask> task, bool isDuplication) {
-    task->cdr.status = isDuplication ? CallStatus::Duplication : CallStatus::Overloaded;
+std::size_t Queue::findIndex(const utility::CallerNumber& number, std::size_t hash) const {
+    auto mask = index_.size() - 1;
+    for (auto i = hash & mask; index_[i].position != npos; i = (i + 1) & mask) {
+        if (index_[i].hash != hash)
+            continue;
+        const auto& queued = ring_[index_[i].position & (ring_.size() - 1)];
+        if (queued.first->getNumber() == number)
+            return i;
+    }
+    return npos;
+}
+
+std::size_t Queue::findIndex(std::size_t position) const {
+    auto mask = index_.size() - 1;
+    for (auto i = hashes_[position & (ring_.size() - 1)] & mask; index_[i].position != npos; i = (i + 1) & mask) {
+        if (index_[i].position == position)
+            return i;
+    }
+    return npos;
+}
+
+void Queue::insertIndex(std::size_t position, std::size_t hash) {
+    auto mask = index_.size() - 1;
+    auto i = hash & mask;
+    while (index_[i].position != npos)
+        i = (i + 1) & mask;
+    index_[i] = IndexEntry{position, hash};
+}
+
+void Queue::eraseIndex(std::size_t hole) {
+    auto mask = index_.size() - 1;
+    index_[hole].position = npos;
+    for (auto i = (hole + 1) & mask; index_[i].position != npos; i = (i + 1) & mask) {
+        auto home = index_[i].hash & mask;
+        // Запись можно перенести в дыру, если дыра лежит между ее домашней позицией и текущей.
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            index_[hole] = index_[i];
+            index_[i].position = npos;
+            hole = i;
+        }
+    }
+}
+
+void Queue::trim() {
+    while (head_ != tail_ && !slot(head_).first)
+        ++head_;
+    while (head_ != tail_ && !slot(tail_ - 1).first)
+        --tail_;
+}
+
+void Queue::rebuild(std::size_t capacity) {
+    std::vector<std::pair<std::shared_ptr<ITask>, CallID>> ring(capacity);
+    std::vector<std::size_t> hashes(capacity);
+    std::vector<Clock::time_point> enqueued(capacity);
+    std::size_t count = 0;
+    for (auto position = head_; position != tail_; ++position) {
+        auto& queued = slot(position);
+        if (queued.first) {
+            hashes[count] = hashes_[position & (ring_.size() - 1)];
+            enqueued[count] = enqueued_[position & (ring_.size() - 1)];
+            ring[count++] = std::move(queued);
+        }
+    }
+    ring_ = std::move(ring);
+    hashes_ = std::move(hashes);
+    enqueued_ = std::move(enqueued);
+    head_ = 0;
+    tail_ = count;
+
+    index_.assign(2 * capacity, IndexEntry{npos, 0});
+    for (auto position = head_; position != tail_; ++position)
+        insertIndex(position, hashes_[position]);
+
+    deadlines_.clear();
+    heapPositions_.assign(capacity, 0);
+    for (auto position = head_; position != tail_; ++position)
+        insertDeadline(position, ring_[position].first->getDeadline());
+
+    if (logger_)
+        SPDLOG_LOGGER_DEBUG(logger_, "Queue storage rebuilt with capacity {}", capacity);
+}
+
+void Queue::processCDR(std::shared_ptr<ITask> task, CallStatus status) {
+    task->cdr.status = status;
     task->cdr.operatorID = 0;
     task->cdr.callDuration = std::chrono::seconds{0};
     task->cdr.endTime = task->cdr.operatorCallTime = std::chrono::system_clock::now();
@@ -87,7 +204,7 @@ void Queue::processCDR(std::shared_ptr<ITask> task, bool isDuplication) {
 }
 
 bool Queue::push(std::pair<std::shared_ptr<ITask>, CallID>&& taskPair) {
-    if (queue_.size() >= sizeOfQueue) {
+    if (size_ >= sizeOfQueue) {
         handleOverloadedTask(taskPair);
         return false;
     }
@@ -98,14 +215,209 @@ bool Queue::push(std::pair<std::shared_ptr<ITask>, CallID>&& taskPair) {
 
 void Queue::pop() {
     if(logger_)
-        logger_->debug("Removing the front of the queue");
-    queue_.erase(queue_.cbegin());
+        SPDLOG_LOGGER_DEBUG(logger_, "Removing the front of the queue");
+    auto found = findIndex(head_);
+    if (found != npos)
+        eraseIndex(found);
+    eraseDeadline(head_);
+    slot(head_) = {};
+    ++head_;
+    --size_;
+    trim();
+}
+
+bool Queue::tryPop(std::pair<std::shared_ptr<ITask>, CallID>& taskPair) {
+    // Оператор не должен получить вызов, срок ожидания которого уже истек.
+    if (!deadlines_.empty())
+        expire(std::chrono::system_clock::now());
+    if (size_ == 0)
+        return false;
+    if (!codel_) {
+        taskPair = std::move(front());
+        pop();
+        return true;
+    }
+
+    // Извлечение по алгоритму CoDel (RFC 8289): отбрасываются только задачи из начала очереди.
+    auto now = Clock::now();
+    auto okToDrop = dequeueHead(taskPair, now);
+    if (dropping_) {
+        if (!okToDrop)
+            dropping_ = false;
+        while (dropping_ && now >= dropNext_) {
+            shedTask(taskPair);
+            ++dropCount_;
+            if (size_ == 0) {
+                dropping_ = false;
+                return false;
+            }
+            if (!dequeueHead(taskPair, now))
+                dropping_ = false;
+            else
+                dropNext_ = controlLaw(dropNext_);
+        }
+    } else if (okToDrop) {
+        shedTask(taskPair);
+        if (size_ == 0)
+            return false;
+        dequeueHead(taskPair, now);
+        dropping_ = true;
+        // Если отбрасывания недавно прекращались, начинаем с прежней частоты, а не с начала.
+        auto delta = dropCount_ - lastCount_;
+        dropCount_ = (delta > 1 && now - dropNext_ < 16 * interval_) ? delta : 1;
+        dropNext_ = controlLaw(now);
+        lastCount_ = dropCount_;
+    }
+    return true;
+}
+
+bool Queue::tryPop(std::pair<std::shared_ptr<ITask>, CallID>& taskPair, std::size_t) {
+    return tryPop(taskPair);
+}
+
+bool Queue::isLockFree() const {
+    return false;
 }
 
 void Queue::update(int size) {
     if(logger_)
-        logger_->info("Queue size updated to {}", size);
+        SPDLOG_LOGGER_INFO(logger_, "Queue size updated to {}", size);
     sizeOfQueue = size;
+    if (ring_.size() < 2 * sizeOfQueue)
+        rebuild(roundUpToPowerOfTwo(2 * sizeOfQueue));
+}
+
+void Queue::setCodel(std::chrono::milliseconds target, std::chrono::milliseconds interval) {
+    if(logger_)
+        SPDLOG_LOGGER_INFO(logger_, "Queue uses CoDel with target {} ms and interval {} ms", target.count(), interval.count());
+    codel_ = true;
+    target_ = target;
+    interval_ = interval;
+    firstAboveTime_ = dropNext_ = {};
+    dropCount_ = lastCount_ = 0;
+    dropping_ = false;
+}
+
+bool Queue::dequeueHead(std::pair<std::shared_ptr<ITask>, CallID>& taskPair, Clock::time_point now) {
+    auto sojourn = now - enqueued_[head_ & (ring_.size() - 1)];
+    taskPair = std::move(front());
+    pop();
+    // Без очереди за извлеченной задачей задержка не растет, отбрасывать нечего.
+    if (sojourn < target_ || size_ == 0) {
+        firstAboveTime_ = {};
+        return false;
+    }
+    if (firstAboveTime_ == Clock::time_point{}) {
+        firstAboveTime_ = now + interval_;
+        return false;
+    }
+    return now >= firstAboveTime_;
+}
+
+void Queue::shedTask(const std::pair<std::shared_ptr<ITask>, CallID>& taskPair) {
+    Result r;
+    processCDR(taskPair.first, CallStatus::Overloaded);
+
+    r.callDuration = std::chrono::seconds{0};
+    r.callID = taskPair.second;
+    r.status = CallStatus::Overloaded;
+
+    if (logger_)
+        SPDLOG_LOGGER_WARN(logger_, "Queue delay stays above {} ms. Task with CallID {} shed, {} tasks left in the queue.",
+                           std::chrono::duration_cast<std::chrono::milliseconds>(target_).count(), r.callID, size_);
+
+    taskPair.first->complete(r);
+}
+
+void Queue::expireTask(const std::pair<std::shared_ptr<ITask>, CallID>& taskPair) {
+    Result r;
+    processCDR(taskPair.first, CallStatus::Timeout);
+
+    r.callDuration = std::chrono::seconds{0};
+    r.callID = taskPair.second;
+    r.status = CallStatus::Timeout;
+
+    if (logger_)
+        SPDLOG_LOGGER_WARN(logger_, "Task with CallID {} waited in the queue longer than RMax and was timed out.", r.callID);
+
+    taskPair.first->complete(r);
+}
+
+std::size_t Queue::expire(std::chrono::system_clock::time_point now) {
+    std::size_t expired = 0;
+    while (!deadlines_.empty() && deadlines_.front().deadline <= now) {
+        auto position = deadlines_.front().position;
+        auto found = findIndex(position);
+        if (found != npos)
+            eraseIndex(found);
+        eraseDeadline(position);
+        auto taskPair = std::move(slot(position));
+        slot(position) = {};
+        --size_;
+        trim();
+
+        expireTask(taskPair);
+        ++expired;
+    }
+    return expired;
+}
+
+std::chrono::system_clock::time_point Queue::nextDeadline() const {
+    return deadlines_.empty() ? std::chrono::system_clock::time_point::max() : deadlines_.front().deadline;
+}
+
+void Queue::insertDeadline(std::size_t position, std::chrono::system_clock::time_point deadline) {
+    deadlines_.push_back(DeadlineEntry{deadline, position});
+    heapPositions_[position & (ring_.size() - 1)] = deadlines_.size() - 1;
+    siftUp(deadlines_.size() - 1);
+}
+
+void Queue::eraseDeadline(std::size_t position) {
+    auto i = heapPositions_[position & (ring_.size() - 1)];
+    auto last = deadlines_.size() - 1;
+    if (i != last) {
+        deadlines_[i] = deadlines_[last];
+        heapPositions_[deadlines_[i].position & (ring_.size() - 1)] = i;
+    }
+    deadlines_.pop_back();
+    if (i < deadlines_.size()) {
+        siftUp(i);
+        siftDown(i);
+    }
+}
+
+void Queue::siftUp(std::size_t i) {
+    auto entry = deadlines_[i];
+    while (i > 0) {
+        auto parent = (i - 1) / 2;
+        if (deadlines_[parent].deadline <= entry.deadline)
+            break;
+        deadlines_[i] = deadlines_[parent];
+        heapPositions_[deadlines_[i].position & (ring_.size() - 1)] = i;
+        i = parent;
+    }
+    deadlines_[i] = entry;
+    heapPositions_[entry.position & (ring_.size() - 1)] = i;
+}
+
+void Queue::siftDown(std::size_t i) {
+    auto entry = deadlines_[i];
+    auto size = deadlines_.size();
+    for (auto child = 2 * i + 1; child < size; child = 2 * i + 1) {
+        if (child + 1 < size && deadlines_[child + 1].deadline < deadlines_[child].deadline)
+            ++child;
+        if (entry.deadline <= deadlines_[child].deadline)
+            break;
+        deadlines_[i] = deadlines_[child];
+        heapPositions_[deadlines_[i].position & (ring_.size() - 1)] = i;
+        i = child;
+    }
+    deadlines_[i] = entry;
+    heapPositions_[entry.position & (ring_.size() - 1)] = i;
+}
+
+Queue::Clock::time_point Queue::controlLaw(Clock::time_point from) const {
+    return from + std::chrono::duration_cast<Clock::duration>(interval_ / std::sqrt(static_cast<double>(dropCount_)));
 }
 
 void Queue::setLogger(std::shared_ptr<spdlog::logger> logger) {
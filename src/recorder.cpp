@@ -1,17 +1,24 @@
 #include "recorder.hpp"
 
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
 /**
  * @file recorder.cpp
- * @brief Содержит определение FileRecorder.
+ * @brief Содержит определение FileRecorder и AsyncFileRecorder.
  */
 
+namespace {
+const std::string cdrHeader = std::string(136, '#') + "\n" +
+    "#DT of the incoming call;Incoming Call ID;Caller number;DT of call termination;Call status;" +
+    "DT operator answer;Operator ID;Call duration#\n" + std::string(136, '#') + "\n";
+}
+
 FileRecorder::FileRecorder(const std::filesystem::path& path) {
     file = std::ofstream (path, std::ios::out|std::ios::app);
-    std::string newL(136, '#');
-    file << newL << std::endl;
-    file << "#DT of the incoming call;Incoming Call ID;Caller number;DT of call termination;Call status;";
-    file << "DT operator answer;Operator ID;Call duration#" << std::endl;
-    file << newL << std::endl;
+    file << cdrHeader << std::flush;
 }
 
 void FileRecorder::makeRecord(const CDR& cdr) {
@@ -19,6 +26,114 @@ void FileRecorder::makeRecord(const CDR& cdr) {
     file << cdr << std::endl;
 }
 
+void FileRecorder::flush() {
+    std::lock_guard<std::mutex> lockGuard(writeMutex_);
+    file.flush();
+}
+
 void FileRecorder::setLogger(std::shared_ptr<spdlog::logger> logger) {
     logger_ = logger;
 }
+
+AsyncFileRecorder::AsyncFileRecorder(const std::filesystem::path& path, CdrDurability durability,
+                                     std::size_t batchSize, std::chrono::milliseconds flushInterval) :
+    durability_(durability), batchSize_(batchSize), flushInterval_(flushInterval) {
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ < 0)
+        throw std::runtime_error("Could not open CDR file " + path.string() + ": " + std::strerror(errno));
+    batch_ = cdrHeader;
+    writeOut(durability_ == CdrDurability::Fdatasync);
+    writer_ = std::thread{&AsyncFileRecorder::run, this};
+}
+
+AsyncFileRecorder::~AsyncFileRecorder() {
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        stop_ = true;
+    }
+    writerAccess_.notify_one();
+    writer_.join();
+    ::close(fd_);
+}
+
+void AsyncFileRecorder::makeRecord(const CDR& cdr) {
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        pending_.push_back(cdr);
+        ++enqueued_;
+        pendingBytes_ += recordSizeEstimate;
+        wake = pendingBytes_ >= batchSize_;
+    }
+    if (wake)
+        writerAccess_.notify_one();
+}
+
+void AsyncFileRecorder::flush() {
+    std::unique_lock<std::mutex> lock(bufferMutex_);
+    auto target = enqueued_;
+    flushRequested_ = true;
+    writerAccess_.notify_one();
+    flushed_.wait(lock, [this, target]() -> bool { return written_ >= target; });
+}
+
+void AsyncFileRecorder::run() {
+    std::vector<CDR> records;
+    std::unique_lock<std::mutex> lock(bufferMutex_);
+    while (true) {
+        auto ready = [this]() -> bool { return stop_ || flushRequested_ || pendingBytes_ >= batchSize_; };
+        // Без гарантий сохранности писатель не просыпается по интервалу.
+        if (durability_ == CdrDurability::None)
+            writerAccess_.wait(lock, ready);
+        else
+            writerAccess_.wait_for(lock, flushInterval_, ready);
+
+        records.swap(pending_);
+        pendingBytes_ = 0;
+        auto target = enqueued_;
+        bool force = flushRequested_ || stop_;
+        bool stopping = stop_;
+        flushRequested_ = false;
+        lock.unlock();
+
+        for (const auto& record: records) {
+            utility::appendCDR(batch_, record);
+            batch_ += '\n';
+        }
+        records.clear();
+        if (durability_ != CdrDurability::None || force || batch_.size() >= batchSize_)
+            writeOut(durability_ == CdrDurability::Fdatasync);
+
+        lock.lock();
+        if (batch_.empty()) {
+            written_ = target;
+            flushed_.notify_all();
+        }
+        if (stopping && pending_.empty())
+            break;
+    }
+}
+
+void AsyncFileRecorder::writeOut(bool sync) {
+    if (batch_.empty())
+        return;
+    std::size_t offset = 0;
+    while (offset < batch_.size()) {
+        auto res = ::write(fd_, batch_.data() + offset, batch_.size() - offset);
+        if (res < 0) {
+            if (errno == EINTR)
+                continue;
+            if (logger_)
+                logger_->error("Could not write CDR batch: {}", std::strerror(errno));
+            break;
+        }
+        offset += static_cast<std::size_t>(res);
+    }
+    batch_.clear();
+    if (sync && ::fdatasync(fd_) != 0 && logger_)
+        logger_->error("Could not sync CDR file: {}", std::strerror(errno));
+}
+
+void AsyncFileRecorder::setLogger(std::shared_ptr<spdlog::logger> logger) {
+    logger_ = logger;
+}
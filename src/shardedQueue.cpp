@@ -0,0 +1,188 @@
+#include "shardedQueue.hpp"
+
+#include <stdexcept>
+
+/**
+ * @file shardedQueue.cpp
+ * @brief Содержит определение класса ShardedQueue,
+ * который реализует интерфейс IQueue.
+ */
+
+using namespace TP;
+
+namespace {
+/// Смещение соседа, с очередью которого оператор сравнивает свою, меняется от вызова к вызову.
+thread_local std::size_t victimCursor = 0;
+}
+
+ShardedQueue::ShardedQueue(int size, std::size_t shards) :
+    IQueue(size), sizeOfQueue(size) {
+    shards_.resize(std::max<std::size_t>(shards, 1));
+    for (auto& shard: shards_)
+        shard = std::make_unique<Shard>();
+}
+
+std::pair<std::shared_ptr<ITask>, CallID>& ShardedQueue::back() {
+    throw std::logic_error("ShardedQueue does not support back()");
+}
+
+std::pair<std::shared_ptr<ITask>, CallID>& ShardedQueue::front() {
+    throw std::logic_error("ShardedQueue does not support front(), use tryPop()");
+}
+
+bool ShardedQueue::empty() const {
+    return size_.load(std::memory_order_acquire) == 0;
+}
+
+bool ShardedQueue::isLockFree() const {
+    return true;
+}
+
+std::size_t ShardedQueue::shardCount() const {
+    return shards_.size();
+}
+
+ShardedQueue::Shard& ShardedQueue::shardFor(const utility::CallerNumber& number) {
+    return *shards_[number.hash() % shards_.size()];
+}
+
+void ShardedQueue::reject(const std::shared_ptr<ITask>& task, CallID callID, CallStatus status) {
+    task->cdr.status = status;
+    task->cdr.operatorID = 0;
+    task->cdr.callDuration = std::chrono::seconds{0};
+    task->cdr.endTime = task->cdr.operatorCallTime = std::chrono::system_clock::now();
+    writeCDR(task->cdr);
+
+    Result r;
+    r.callDuration = std::chrono::seconds{0};
+    r.callID = callID;
+    r.status = status;
+    task->complete(r);
+}
+
+bool ShardedQueue::push(std::pair<std::shared_ptr<ITask>, CallID>&& taskPair) {
+    auto task = taskPair.first;
+    auto callID = taskPair.second;
+    if (size_.fetch_add(1, std::memory_order_acq_rel) >= sizeOfQueue.load(std::memory_order_relaxed)) {
+        size_.fetch_sub(1, std::memory_order_acq_rel);
+        if (logger_)
+            SPDLOG_LOGGER_WARN(logger_, "Queue is overloaded. Max size {}. Task with CallID {} rejected.", sizeOfQueue.load(),
+                          callID);
+        reject(task, callID, CallStatus::Overloaded);
+        return false;
+    }
+
+    auto& shard = shardFor(task->getNumber());
+    std::shared_ptr<ITask> duplicate;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(task->getNumber());
+        if (it != shard.index.end()) {
+            duplicate = std::move(it->second);
+            shard.index.erase(it);
+        }
+        shard.index.emplace(task->getNumber(), task);
+        shard.tasks.push_back(Entry{std::move(taskPair), sequence_.fetch_add(1, std::memory_order_relaxed)});
+    }
+
+    if (duplicate) {
+        size_.fetch_sub(1, std::memory_order_acq_rel);
+        if (logger_)
+            SPDLOG_LOGGER_WARN(logger_, "Duplicate task with CallID {}. Removed from the queue.", duplicate->cdr.callID);
+        reject(duplicate, duplicate->cdr.callID, CallStatus::Duplication);
+    }
+
+    if (logger_)
+        SPDLOG_LOGGER_INFO(logger_, "Task with CallID {}. Was added to the queue", callID);
+    return true;
+}
+
+void ShardedQueue::skipReplaced(Shard& shard) {
+    while (!shard.tasks.empty()) {
+        const auto& task = shard.tasks.front().taskPair.first;
+        auto it = shard.index.find(task->getNumber());
+        if (it != shard.index.end() && it->second == task)
+            return;
+        // Задача была заменена дубликатом и уже завершена.
+        shard.tasks.pop_front();
+    }
+}
+
+std::uint64_t ShardedQueue::headSequence(std::size_t shard) {
+    auto& local = *shards_[shard];
+    std::lock_guard<std::mutex> lock(local.mutex);
+    skipReplaced(local);
+    return local.tasks.empty() ? none : local.tasks.front().sequence;
+}
+
+bool ShardedQueue::popFrom(std::size_t shard, std::pair<std::shared_ptr<ITask>, CallID>& taskPair) {
+    auto& local = *shards_[shard];
+    {
+        std::lock_guard<std::mutex> lock(local.mutex);
+        skipReplaced(local);
+        if (local.tasks.empty())
+            return false;
+        taskPair = std::move(local.tasks.front().taskPair);
+        local.tasks.pop_front();
+        local.index.erase(taskPair.first->getNumber());
+    }
+    size_.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+bool ShardedQueue::tryPop(std::pair<std::shared_ptr<ITask>, CallID>& taskPair) {
+    return tryPop(taskPair, 0);
+}
+
+bool ShardedQueue::tryPop(std::pair<std::shared_ptr<ITask>, CallID>& taskPair, std::size_t worker) {
+    if (empty())
+        return false;
+    auto count = shards_.size();
+    auto home = worker % count;
+    if (count > 1) {
+        // Из двух очередей берется задача, которая ждет дольше.
+        auto victim = (home + 1 + victimCursor++ % (count - 1)) % count;
+        auto homeHead = headSequence(home);
+        auto victimHead = headSequence(victim);
+        if (victimHead < homeHead && popFrom(victim, taskPair))
+            return true;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        if (popFrom((home + i) % count, taskPair))
+            return true;
+    }
+    return false;
+}
+
+void ShardedQueue::pop() {
+    std::pair<std::shared_ptr<ITask>, CallID> taskPair;
+    tryPop(taskPair);
+}
+
+void ShardedQueue::update(int size) {
+    if (logger_)
+        SPDLOG_LOGGER_INFO(logger_, "Queue size updated to {}", size);
+    sizeOfQueue.store(static_cast<std::size_t>(std::max(size, 0)), std::memory_order_relaxed);
+}
+
+void ShardedQueue::setLogger(std::shared_ptr<spdlog::logger> logger) {
+    this->logger_ = logger;
+}
+
+void ShardedQueue::setRecorders(std::vector<std::shared_ptr<IRecorder>> recorders) {
+    recorders_ = recorders;
+}
+
+void ShardedQueue::writeCDR(const CDR& cdr) {
+    std::lock_guard<std::mutex> lock(cdrMutex_);
+    for (const auto& recorder: recorders_)
+        recorder->makeRecord(cdr);
+}
+
+std::size_t ShardedQueue::expire([[maybe_unused]] std::chrono::system_clock::time_point now) {
+    return 0;
+}
+
+std::chrono::system_clock::time_point ShardedQueue::nextDeadline() const {
+    return std::chrono::system_clock::time_point::max();
+}
@@ -1,5 +1,3 @@
-#include <random>
-
 #include "task.hpp"
 
 /**
@@ -11,31 +9,63 @@ using namespace TP;
 using std::string_literals::operator""s;
 
 Task::Task(int RMin, int RMax, std::string_view number, const std::chrono::system_clock::time_point& startTime, std::shared_ptr<spdlog::logger> logger)
-    : ITask(RMin, RMax, number, startTime, logger), RMin_(RMin), RMax_(RMax), number_(number), logger_(logger) {
+    : Task(RMin, RMax, number, startTime, std::move(logger), std::make_shared<std::promise<Result>>()) {
+}
+
+Task::Task(int RMin, int RMax, std::string_view number, const std::chrono::system_clock::time_point& startTime,
+           std::shared_ptr<spdlog::logger> logger, std::shared_ptr<std::promise<Result>> promise)
+    : ITask(RMin, RMax, number, startTime, logger), RMin_(RMin), RMax_(RMax), logger_(std::move(logger)) {
     if(logger_) {
-        logger_->info("Creating Task with RMin: {} RMax: {}", std::to_string(RMin_), std::to_string(RMax_));
-        logger_->debug("Task initialized with number: {}", std::string{number_});
+        SPDLOG_LOGGER_INFO(logger_, "Creating Task with RMin: {} RMax: {}", RMin_, RMax_);
+        SPDLOG_LOGGER_DEBUG(logger_, "Task initialized with number: {}", number);
     }
     cdr.startTime = startTime;
     cdr.number = number;
-    promise_ = std::make_shared<std::promise<Result>>();
+    promise_ = std::move(promise);
 }
 
 void Task::setCallID(TP::CallID& id) {
     this->taskId_ = id;
     cdr.callID = id;
-    logger_->info("Setting CallID to task with number {}: {} ", std::string{number_}, std::to_string(id));
+    if(logger_)
+        SPDLOG_LOGGER_INFO(logger_, "Setting CallID to task with number {}: {} ", cdr.number.view(), id);
 }
 
 
 void Task::setThreadID(std::size_t& id) {
     cdr.operatorID = id;
-    logger_->info("Setting ThreadID to task with number {}: {}", std::string{number_}, std::to_string(id));
+    if(logger_)
+        SPDLOG_LOGGER_INFO(logger_, "Setting ThreadID to task with number {}: {}", cdr.number.view(), id);
 }
 
 void Task::addPromise(std::shared_ptr<std::promise<Result>> t) {
     promise_ = t;
-    logger_->debug("Added promise for Task");
+    if(logger_)
+        SPDLOG_LOGGER_DEBUG(logger_, "Added promise for Task");
+}
+
+void Task::addCompletionHandler(CompletionHandler handler) {
+    onComplete_ = std::move(handler);
+    if(logger_)
+        SPDLOG_LOGGER_DEBUG(logger_, "Added completion handler for Task");
+}
+
+void Task::setDurationGenerator(std::shared_ptr<const DurationGenerator> generator) {
+    durationGenerator_ = std::move(generator);
+}
+
+void Task::complete(const Result& result) {
+    if(promise_)
+        promise_->set_value(result);
+    if(onComplete_)
+        onComplete_(nullptr, result);
+}
+
+void Task::fail(std::exception_ptr exception) {
+    if(promise_)
+        promise_->set_exception(exception);
+    if(onComplete_)
+        onComplete_(exception, createResultObject());
 }
 
 
@@ -43,23 +73,24 @@ CallID Task::getCallID() const {
     return this->taskId_;
 }
 
-std::string_view Task::getNumber() {
-    return this->number_;
+const utility::CallerNumber& Task::getNumber() {
+    return cdr.number;
+}
+
+std::chrono::system_clock::time_point Task::getDeadline() const {
+    return cdr.startTime + std::chrono::seconds{RMax_};
 }
 
 std::chrono::seconds Task::getDuration() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> distrib(RMin_, RMax_);
-    auto temp = distrib(gen);
-    std::chrono::seconds randomSeconds(temp);
-    return randomSeconds;
+    if (durationGenerator_)
+        return durationGenerator_->next();
+    return DurationGenerator(DurationDistribution::Uniform, RMin_, RMax_).next();
 }
 
 
 void Task::setCdrValues(const std::chrono::seconds& timeDiff) {
     if(logger_) {
-        logger_->info("Setting cdr values for call with number: {} and callID: {}", number_, taskId_);
+        SPDLOG_LOGGER_INFO(logger_, "Setting cdr values for call with number: {} and callID: {}", cdr.number.view(), taskId_);
     }
     cdr.operatorCallTime = std::chrono::system_clock::now();
     cdr.callDuration = (timeDiff.count() < RMax_) ? getDuration() : std::chrono::seconds{0};
@@ -69,23 +100,24 @@ void Task::setCdrValues(const std::chrono::seconds& timeDiff) {
 
 void Task::logCallDetails() {
     if (logger_) {
-        logger_->info("Call with number: {} {} for {} seconds",
-                      cdr.number, (cdr.status == CallStatus::Completed) ? "will sleep" : "was timed out",
+        SPDLOG_LOGGER_INFO(logger_, "Call with number: {} {} for {} seconds",
+                      cdr.number.view(), (cdr.status == CallStatus::Completed) ? "will sleep" : "was timed out",
                       cdr.callDuration.count());
-        logger_->debug("Sleeping for {} seconds", cdr.callDuration.count());
+        SPDLOG_LOGGER_DEBUG(logger_, "Sleeping for {} seconds", cdr.callDuration.count());
         if (cdr.status == CallStatus::Completed)
             std::this_thread::sleep_for(cdr.callDuration);
     }
 
     cdr.endTime = std::chrono::system_clock::now();
 
-    logger_->debug("Call with number {} and callID {} {}",
-                   cdr.number, taskId_, (cdr.status == CallStatus::Completed) ? "completed successfully" : "timed out");
+    if(logger_)
+        SPDLOG_LOGGER_DEBUG(logger_, "Call with number {} and callID {} {}",
+                       cdr.number.view(), taskId_, (cdr.status == CallStatus::Completed) ? "completed successfully" : "timed out");
 }
 
 Result Task::createResultObject() const {
     if(logger_)
-        logger_->info("Filling result variable");
+        SPDLOG_LOGGER_INFO(logger_, "Filling result variable");
     Result r;
     r.status = cdr.status;
     r.callDuration = cdr.callDuration;
@@ -102,12 +134,33 @@ Result Task::doTask() {
         setCdrValues(timeDiff);
         logCallDetails();
 
-        logger_->info("Writing CDR for task with number: {}", cdr.number);
+        if(logger_)
+            SPDLOG_LOGGER_INFO(logger_, "Writing CDR for task with number: {}", cdr.number.view());
 
         return createResultObject();
     } catch (const std::exception& e) {
-        logger_->error("Exception in doTask: {}", e.what());
-        promise_->set_exception(std::current_exception());
+        if(logger_)
+            SPDLOG_LOGGER_ERROR(logger_, "Exception in doTask: {}", e.what());
         throw;
     }
 }
+
+std::chrono::seconds Task::beginCall() {
+    auto now = std::chrono::system_clock::now();
+    auto timeDiff = std::chrono::duration_cast<std::chrono::seconds>(now - cdr.startTime);
+
+    setCdrValues(timeDiff);
+    if (logger_)
+        SPDLOG_LOGGER_INFO(logger_, "Call with number: {} {} for {} seconds",
+                      cdr.number.view(), (cdr.status == CallStatus::Completed) ? "occupies operator" : "was timed out",
+                      cdr.callDuration.count());
+    return (cdr.status == CallStatus::Completed) ? std::chrono::seconds{cdr.callDuration} : std::chrono::seconds{0};
+}
+
+Result Task::finishCall() {
+    cdr.endTime = std::chrono::system_clock::now();
+    if (logger_)
+        SPDLOG_LOGGER_DEBUG(logger_, "Call with number {} and callID {} {}",
+                       cdr.number.view(), taskId_, (cdr.status == CallStatus::Completed) ? "completed successfully" : "timed out");
+    return createResultObject();
+}
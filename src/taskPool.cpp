@@ -0,0 +1,115 @@
+#include "taskPool.hpp"
+#include "task.hpp"
+
+#include <mutex>
+#include <new>
+#include <vector>
+
+/**
+ * @file taskPool.cpp
+ * @brief Содержит определение класса TaskPool
+ */
+
+using namespace TP;
+
+/**
+ * @brief Пластины пула и список свободных блоков.
+ * Свободный блок хранит указатель на следующий свободный блок в своих первых байтах.
+ */
+struct TaskPool::Storage {
+    struct alignas(std::max_align_t) Block {
+        std::byte data[blockSize];
+    };
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    void* allocate(std::size_t bytes) {
+        if (bytes > blockSize)
+            return ::operator new(bytes);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!free)
+            grow();
+        auto* block = free;
+        free = block->next;
+        return block;
+    }
+
+    void deallocate(void* pointer, std::size_t bytes) {
+        if (bytes > blockSize)
+            return ::operator delete(pointer);
+        std::lock_guard<std::mutex> lock(mutex);
+        free = new (pointer) FreeBlock{free};
+    }
+
+    void grow() {
+        auto& slab = slabs.emplace_back(std::make_unique<Block[]>(blocksPerSlab));
+        for (std::size_t i = blocksPerSlab; i-- > 0;)
+            free = new (&slab[i]) FreeBlock{free};
+    }
+
+    mutable std::mutex mutex; ///< Мьютекс списка свободных блоков и пластин.
+    FreeBlock* free = nullptr; ///< Список свободных блоков.
+    std::vector<std::unique_ptr<Block[]>> slabs; ///< Пластины.
+};
+
+/**
+ * @brief Аллокатор для allocate_shared и std::promise, выделяющий память из пула.
+ * Хранит владение пулом, поэтому объекты пула переживают TaskPool.
+ */
+template <class T>
+class TaskPool::Allocator {
+public:
+    using value_type = T;
+
+    explicit Allocator(std::shared_ptr<Storage> storage) : storage_(std::move(storage)) {}
+
+    template <class U>
+    Allocator(const Allocator<U>& other) : storage_(other.storage_) {}
+
+    T* allocate(std::size_t n) {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "TaskPool blocks are max_align_t aligned");
+        return static_cast<T*>(storage_->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* pointer, std::size_t n) {
+        storage_->deallocate(pointer, n * sizeof(T));
+    }
+
+    template <class U>
+    bool operator==(const Allocator<U>& other) const {
+        return storage_ == other.storage_;
+    }
+
+    template <class U>
+    bool operator!=(const Allocator<U>& other) const {
+        return storage_ != other.storage_;
+    }
+
+private:
+    template <class U>
+    friend class Allocator;
+
+    std::shared_ptr<Storage> storage_; ///< Память пула.
+};
+
+TaskPool::TaskPool() : storage_(std::make_shared<Storage>()) {
+}
+
+std::shared_ptr<ITask> TaskPool::makeTask(int RMin, int RMax, std::string_view number,
+                                          const std::chrono::system_clock::time_point& startTime,
+                                          std::shared_ptr<spdlog::logger> logger) {
+    return std::allocate_shared<Task>(Allocator<Task>(storage_), RMin, RMax, number, startTime, std::move(logger),
+                                      nullptr);
+}
+
+std::shared_ptr<std::promise<Result>> TaskPool::makePromise() {
+    Allocator<std::promise<Result>> allocator(storage_);
+    return std::allocate_shared<std::promise<Result>>(allocator, std::allocator_arg, allocator);
+}
+
+std::size_t TaskPool::capacity() const {
+    std::lock_guard<std::mutex> lock(storage_->mutex);
+    return storage_->slabs.size() * blocksPerSlab;
+}
@@ -1,6 +1,7 @@
 #include "threadpool.hpp"
 #include "queue.hpp"
 #include "spdlog/spdlog.h"
+#include <algorithm>
 #include <iostream>
 #include <random>
 
@@ -11,38 +12,155 @@
  */
 using namespace TP;
 
-ThreadPool::ThreadPool(unsigned amountOfThreads, unsigned sizeOfQueue):
-    IThreadPool(amountOfThreads, sizeOfQueue) {
+ThreadPool::ThreadPool(unsigned amountOfThreads, unsigned sizeOfQueue, OperatorMode mode):
+    IThreadPool(amountOfThreads, sizeOfQueue), mode_(mode), operators_(amountOfThreads) {
     stopped = false;
     paused = true;
+    lockFree_ = false;
+    wakeups_ = 0;
+    queueVersion_ = 0;
+    idle_ = 0;
     task_queue = std::make_shared<Queue>(sizeOfQueue);
+    callIdGenerator_ = std::make_shared<CallIdGenerator>();
     completed_task_count = 0;
-    for (unsigned int i = 0; i < amountOfThreads; i++) {
-        auto* th = new Thread;
-        th->_thread = std::thread{&ThreadPool::run, this, th};
-        th->is_working = false;
-        threads.push_back(th);
+    busy_ = 0;
+    retiring_ = 0;
+    nextIndex_ = 0;
+    auto workers = amountOfThreads;
+    if (mode_ == OperatorMode::TimerWheel) {
+        // Рабочие потоки только начинают вызовы, поэтому их достаточно по числу ядер.
+        workers = std::min(amountOfThreads, std::max(1u, std::thread::hardware_concurrency()));
+        wheel_ = std::make_unique<TimerWheel>();
+        wheelThread_ = std::thread{&ThreadPool::runWheel, this};
     }
+    deadlineThread_ = std::thread{&ThreadPool::runDeadlines, this};
+    std::lock_guard<std::mutex> lock(workersMutex_);
+    for (unsigned int i = 0; i < workers; i++)
+        spawnWorker();
+}
+
+void ThreadPool::spawnWorker() {
+    auto* th = new Thread;
+    th->index = nextIndex_++;
+    th->is_working = false;
+    th->_thread = std::thread{&ThreadPool::run, this, th};
+    threads.push_back(th);
+}
+
+bool ThreadPool::retireIfRequested(Thread* pOperator) {
+    if (retiring_ == 0)
+        return false;
+    std::lock_guard<std::mutex> lock(workersMutex_);
+    if (retiring_ == 0)
+        return false;
+    --retiring_;
+    pOperator->retired = true;
+    if(logger_)
+        SPDLOG_LOGGER_INFO(logger_, "Operator {} retired", pOperator->index);
+    return true;
+}
+
+void ThreadPool::reapRetired() {
+    auto it = std::remove_if(threads.begin(), threads.end(), [](Thread* thread) {
+        if (!thread->retired)
+            return false;
+        if (thread->_thread.joinable())
+            thread->_thread.join();
+        delete thread;
+        return true;
+    });
+    threads.erase(it, threads.end());
+}
+
+std::size_t ThreadPool::activeWorkers() const {
+    std::size_t running = std::count_if(threads.begin(), threads.end(),
+                                        [](const Thread* thread) { return !thread->retired; });
+    return running - retiring_;
+}
+
+void ThreadPool::resize(unsigned amountOfOperators) {
+    amountOfOperators = std::max(1u, amountOfOperators);
+    {
+        std::lock_guard<std::mutex> lock(workersMutex_);
+        reapRetired();
+        std::size_t desired = amountOfOperators;
+        if (mode_ == OperatorMode::TimerWheel) {
+            operators_ = amountOfOperators;
+            desired = std::min(amountOfOperators, std::max(1u, std::thread::hardware_concurrency()));
+        }
+        auto active = activeWorkers();
+        if (desired > active) {
+            // Сначала отменяются еще не выполненные завершения, затем запускаются новые потоки.
+            auto cancel = std::min<std::size_t>(retiring_, desired - active);
+            retiring_ -= static_cast<unsigned>(cancel);
+            for (auto i = active + cancel; i < desired; ++i)
+                spawnWorker();
+        } else if (desired < active) {
+            retiring_ += static_cast<unsigned>(active - desired);
+        }
+        if(logger_)
+            SPDLOG_LOGGER_INFO(logger_, "Thread pool resized to {} operators ({} worker threads)", amountOfOperators, desired);
+    }
+    // Пустой захват мьютекса исключает потерю пробуждения оператора, проверяющего условие ожидания.
+    { std::lock_guard<std::mutex> lock(task_queue_mutex); }
+    wakeOperators();
 }
 
 bool ThreadPool::run_allowed() const {
     if(task_queue)
-        return (!task_queue->empty() && !paused);
+        return (!task_queue->empty() && !paused && operatorAvailable());
     if(logger_)
-        logger_->critical("There is no task_queue set up");
+        SPDLOG_LOGGER_CRITICAL(logger_, "There is no task_queue set up");
     return false;
 }
 
+bool ThreadPool::operatorAvailable() const {
+    return mode_ != OperatorMode::TimerWheel || busy_ < operators_;
+}
+
+bool ThreadPool::acquireOperator() {
+    if (mode_ != OperatorMode::TimerWheel)
+        return true;
+    if (++busy_ <= operators_)
+        return true;
+    --busy_;
+    return false;
+}
+
+void ThreadPool::releaseOperators(std::size_t count) {
+    {
+        std::lock_guard<std::mutex> lock(task_queue_mutex);
+        busy_ -= static_cast<unsigned>(count);
+    }
+    wakeOperators();
+}
+
 void ThreadPool::run(Thread* pOperator) {
     while (!stopped) {
+        if (retireIfRequested(pOperator))
+            return;
+        if (lockFree_) {
+            if (!runLockFree(pOperator))
+                break;
+            continue;
+        }
         std::unique_lock<std::mutex> lock(task_queue_mutex);
 
         pOperator->is_working = false;
-        tasks_access.wait(lock, [this]() -> bool { return run_allowed() || stopped; });
+        tasks_access.wait(lock, [this]() -> bool { return run_allowed() || stopped || lockFree_ || retiring_ > 0; });
+        if (lockFree_ || retiring_ > 0)
+            continue;
         pOperator->is_working = true;
         if (run_allowed()) {
             // TODO: тут должно быть лог сообщение
             auto[task, callID] = processTask();
+            if (!task) {
+                // Очередь с CoDel могла отбросить все ожидавшие задачи.
+                wait_access.notify_all();
+                continue;
+            }
+            if (mode_ == OperatorMode::TimerWheel)
+                ++busy_;
             lock.unlock();
             executeTask(task, callID);
 
@@ -56,45 +174,174 @@ void ThreadPool::run(Thread* pOperator) {
     }
 }
 
+bool ThreadPool::runLockFree(Thread* pOperator) {
+    std::shared_ptr<IQueue> queue;
+    std::uint32_t version;
+    {
+        std::lock_guard<std::mutex> lock(task_queue_mutex);
+        queue = task_queue;
+        version = queueVersion_;
+    }
+    while (!stopped && lockFree_ && version == queueVersion_ && retiring_ == 0) {
+        auto epoch = wakeups_.load();
+        std::pair<std::shared_ptr<ITask>, CallID> taskPair;
+        if (!paused && acquireOperator()) {
+            if (queue->tryPop(taskPair, pOperator->index)) {
+                pOperator->is_working = true;
+                auto threadId = std::hash<std::thread::id>{}(std::this_thread::get_id());
+                taskPair.first->setThreadID(threadId);
+                if(logger_)
+                    SPDLOG_LOGGER_INFO(logger_, "Task with CallID: {} in work", taskPair.second);
+                executeTask(taskPair.first, taskPair.second);
+                pOperator->is_working = false;
+
+                if (waitForCompletion && queue->empty())
+                    return false;
+
+                completed_task_count++;
+                wait_access.notify_all();
+                continue;
+            }
+            if (mode_ == OperatorMode::TimerWheel)
+                --busy_;
+        }
+        ++idle_;
+        wakeups_.wait(epoch);
+        --idle_;
+    }
+    return true;
+}
+
+void ThreadPool::wakeOperators() {
+    ++wakeups_;
+    wakeups_.notify_all();
+    tasks_access.notify_all();
+}
+
+void ThreadPool::onQueueChanged() {
+    lockFree_ = task_queue && task_queue->isLockFree();
+    ++queueVersion_;
+    wakeOperators();
+    deadlineAccess_.notify_one();
+}
+
 void ThreadPool::executeTask(std::shared_ptr<ITask>& task, CallID callID) {
+    if (mode_ == OperatorMode::TimerWheel)
+        return scheduleTask(task, callID);
     try {
         auto res = task->doTask();
         task_queue->writeCDR(task->cdr);
         if(logger_)
-            logger_->info("Task with CallID: " + std::to_string(callID) + " was successfully completed");
-        task->promise_->set_value(res);
+            SPDLOG_LOGGER_INFO(logger_, "Task with CallID: {} was successfully completed", callID);
+        task->complete(res);
+    } catch (...) {
+        if(logger_)
+            SPDLOG_LOGGER_ERROR(logger_, "Task with CallID: {} was terminated with an exception thrown", callID);
+        task->fail(std::current_exception());
+    }
+}
+
+void ThreadPool::scheduleTask(const std::shared_ptr<ITask>& task, CallID callID) {
+    std::chrono::seconds duration;
+    try {
+        duration = task->beginCall();
+    } catch (...) {
+        if(logger_)
+            SPDLOG_LOGGER_ERROR(logger_, "Task with CallID: {} was terminated with an exception thrown", callID);
+        task->fail(std::current_exception());
+        releaseOperators(1);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(wheelMutex_);
+        wheel_->schedule(TimerWheel::Clock::now(), duration, [this, task, callID]() { finishTask(task, callID); });
+    }
+    wheelAccess_.notify_one();
+}
+
+void ThreadPool::finishTask(const std::shared_ptr<ITask>& task, [[maybe_unused]] CallID callID) {
+    try {
+        auto res = task->finishCall();
+        task_queue->writeCDR(task->cdr);
+        if(logger_)
+            SPDLOG_LOGGER_INFO(logger_, "Task with CallID: {} was successfully completed", callID);
+        task->complete(res);
     } catch (...) {
         if(logger_)
-            logger_->error("Task with CallID: " + std::to_string(callID) +
-                           " was terminated with an exception thrown");
-        task->promise_->set_exception(std::current_exception());
+            SPDLOG_LOGGER_ERROR(logger_, "Task with CallID: {} was terminated with an exception thrown", callID);
+        task->fail(std::current_exception());
+    }
+}
+
+void ThreadPool::runWheel() {
+    std::unique_lock<std::mutex> lock(wheelMutex_);
+    // После остановки пула поток дожидается окончания уже начатых разговоров.
+    while (!stopped || !wheel_->empty()) {
+        if (wheel_->empty())
+            wheelAccess_.wait(lock, [this]() -> bool { return stopped || !wheel_->empty(); });
+        else
+            wheelAccess_.wait_until(lock, wheel_->nextExpiry());
+
+        auto expired = wheel_->advance(TimerWheel::Clock::now());
+        if (expired.empty())
+            continue;
+        lock.unlock();
+        for (auto& callback: expired)
+            callback();
+        releaseOperators(expired.size());
+        lock.lock();
+    }
+}
+
+void ThreadPool::runDeadlines() {
+    std::unique_lock<std::mutex> lock(task_queue_mutex);
+    while (!stopped) {
+        // Приостановленный пул мог передать очередь новому пулу, поэтому сроки отслеживает только работающий пул.
+        auto deadline = (task_queue && !paused) ? task_queue->nextDeadline()
+                                                : std::chrono::system_clock::time_point::max();
+        if (deadline == std::chrono::system_clock::time_point::max()) {
+            deadlineAccess_.wait(lock);
+            continue;
+        }
+        if (deadlineAccess_.wait_until(lock, deadline) == std::cv_status::no_timeout)
+            continue;
+        if (stopped || paused || !task_queue)
+            continue;
+        auto expired = task_queue->expire(std::chrono::system_clock::now());
+        if (expired > 0 && logger_)
+            SPDLOG_LOGGER_INFO(logger_, "{} calls timed out while waiting in the queue", expired);
     }
 }
 
 std::pair<std::shared_ptr<ITask>, CallID> ThreadPool::processTask() {
-    auto res = std::move(task_queue->front());
+    std::pair<std::shared_ptr<ITask>, CallID> res;
+    if (!task_queue->tryPop(res))
+        return res;
     auto threadId =  std::hash<std::thread::id>{}(std::this_thread::get_id());
     res.first->setThreadID(threadId);
     if(logger_)
-        logger_->info("Task with CallID: " + std::to_string(res.second) + " in work");
-    task_queue->pop();
+        SPDLOG_LOGGER_INFO(logger_, "Task with CallID: {} in work", res.second);
     return res;
 }
 
 void ThreadPool::start() {
     if(logger_)
-        logger_->info("Starting threadpool");
+        SPDLOG_LOGGER_INFO(logger_, "Starting threadpool");
     if (paused||stopped) {
         stopped = false;
-        paused = false;
+        {
+            std::lock_guard<std::mutex> lock(task_queue_mutex);
+            paused = false;
+        }
         waitForCompletion = false;
-        tasks_access.notify_all();
+        wakeOperators();
+        deadlineAccess_.notify_one();
     }
 }
 
 void ThreadPool::stop() {
     if(logger_)
-        logger_->info("Stopping thread pool");
+        SPDLOG_LOGGER_INFO(logger_, "Stopping thread pool");
     paused = true;
     waitForCompletion = true;
 }
@@ -103,31 +350,76 @@ void ThreadPool::transferObjects(const std::shared_ptr<IThreadPool>& oldThreadPo
     std::lock_guard<std::mutex> oldPoolLock(oldThreadPool->task_queue_mutex);
     std::lock_guard<std::mutex> thisPoolLock(task_queue_mutex);
     if(logger_)
-        logger_->info("Transfering code task queue");
+        SPDLOG_LOGGER_INFO(logger_, "Transfering code task queue");
     if(this != oldThreadPool.get()) {
         this->task_queue = oldThreadPool->task_queue;
+        if (auto oldPool = std::dynamic_pointer_cast<ThreadPool>(oldThreadPool))
+            callIdGenerator_ = oldPool->callIdGenerator_;
+        onQueueChanged();
     }
 }
 
 std::pair<CallID, std::future<Result>> ThreadPool::add_task(std::shared_ptr<ITask> task) {
-    // TODO: тут должно быть лог сообщение
-    std::lock_guard<std::mutex> lock(task_queue_mutex);
-    auto callID = generateCallID(std::stoll(std::string{task->getNumber()}));
+    if (!task->promise_)
+        task->addPromise(std::make_shared<std::promise<Result>>());
+    auto future = task->promise_->get_future();
+    auto callID = enqueueTask(task);
+    return std::make_pair(callID, std::move(future));
+}
 
+CallID ThreadPool::add_task(std::shared_ptr<ITask> task, CompletionHandler handler) {
+    task->addCompletionHandler(std::move(handler));
+    return enqueueTask(task);
+}
 
+CallID ThreadPool::reject(std::shared_ptr<ITask> task, CallStatus status) {
+    auto callID = generateCallID();
     task->setCallID(callID);
-    auto future = task->promise_->get_future();
+    task->cdr.status = status;
+    task->cdr.operatorID = 0;
+    task->cdr.callDuration = std::chrono::seconds{0};
+    task->cdr.endTime = task->cdr.operatorCallTime = std::chrono::system_clock::now();
+    // Очередь пишет CDR под собственным мьютексом, мьютекс пула не нужен.
+    if (task_queue)
+        task_queue->writeCDR(task->cdr);
+    if (logger_)
+        SPDLOG_LOGGER_INFO(logger_, "Task with CallID: {} was completed with status {} without queueing",
+                           callID, utility::to_string(status));
+    task->complete(Result{status, std::chrono::seconds{0}, callID});
+    return callID;
+}
+
+CallID ThreadPool::enqueueTask(const std::shared_ptr<ITask>& task) {
+    // TODO: тут должно быть лог сообщение
+    if (lockFree_) {
+        // Очередь потокобезопасна сама по себе, мьютекс пула не нужен.
+        auto callID = generateCallID();
+        task->setCallID(callID);
+        if (task_queue->push(std::make_pair(task, callID))) {
+            ++wakeups_;
+            if (idle_ > 0)
+                wakeups_.notify_one();
+        }
+        return callID;
+    }
+    auto callID = generateCallID();
+    task->setCallID(callID);
+
+    std::lock_guard<std::mutex> lock(task_queue_mutex);
 
 
     if(task_queue) {
+        auto deadline = task_queue->nextDeadline();
         if(task_queue->push(std::make_pair(task, callID))) {
             tasks_access.notify_one();
         }
+        if(task_queue->nextDeadline() < deadline)
+            deadlineAccess_.notify_one();
     } else {
         if(logger_)
-            logger_->critical("There is no task_queue set up");
+            SPDLOG_LOGGER_CRITICAL(logger_, "There is no task_queue set up");
     }
-    return std::make_pair(callID, std::move(future));
+    return callID;
 }
 
 
@@ -136,39 +428,59 @@ ThreadPool::~ThreadPool() {
         std::lock_guard<std::mutex> lock(task_queue_mutex);
         stopped = true;
     }
-    tasks_access.notify_all();
+    wakeOperators();
+    deadlineAccess_.notify_one();
+    deadlineThread_.join();
     for (auto& thread: threads) {
         if(thread->_thread.joinable()) {
             thread->_thread.join();
         }
         delete thread;
     }
+    if (wheelThread_.joinable()) {
+        { std::lock_guard<std::mutex> lock(wheelMutex_); }
+        wheelAccess_.notify_all();
+        wheelThread_.join();
+    }
 }
 
 void ThreadPool::setTaskQueue(std::shared_ptr<IQueue> task_queue) {
     std::lock_guard<std::mutex> thisPoolLock(task_queue_mutex);
     if(logger_)
-        logger_->info("Thread pool set up task queue");
+        SPDLOG_LOGGER_INFO(logger_, "Thread pool set up task queue");
     this->task_queue = task_queue;
+    onQueueChanged();
 }
 
-CallID ThreadPool::generateCallID(long long number) {
-    auto threadID = std::hash<std::thread::id>{}(std::this_thread::get_id());
-    CallID res{threadID+number};
+CallID ThreadPool::generateCallID() {
+    auto res = callIdGenerator_->next();
     if(logger_)
-        logger_->info("Generated CallID: " + std::to_string(res) + " for call with number: " + std::to_string(number));
+        SPDLOG_LOGGER_INFO(logger_, "Generated CallID: {}", res);
     return res;
 }
 
+void ThreadPool::setCallIdGenerator(std::shared_ptr<CallIdGenerator> generator) {
+    std::lock_guard<std::mutex> lock(task_queue_mutex);
+    callIdGenerator_ = std::move(generator);
+}
+
 void ThreadPool::setLogger(std::shared_ptr<spdlog::logger> logger) {
     this->logger_ = logger;
     if(logger_) {
         task_queue->setLogger(logger);
-        logger_->info("ThreadPoll set up logger");
+        SPDLOG_LOGGER_INFO(logger_, "ThreadPoll set up logger");
     }
 }
 
 
 std::size_t ThreadPool::getSize() {
-    return threads.size();
+    if (mode_ == OperatorMode::TimerWheel)
+        return operators_;
+    std::lock_guard<std::mutex> lock(workersMutex_);
+    return activeWorkers();
+}
+
+std::size_t ThreadPool::getWorkerCount() const {
+    std::lock_guard<std::mutex> lock(workersMutex_);
+    return activeWorkers();
 }
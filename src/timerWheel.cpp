@@ -0,0 +1,99 @@
+#include "timerWheel.hpp"
+
+#include <algorithm>
+
+/**
+ * @file timerWheel.cpp
+ * @brief Содержит определение класса TimerWheel
+ */
+
+using namespace TP;
+
+TimerWheel::TimerWheel(Clock::duration tick, Clock::time_point start) :
+    tick_(tick), start_(start) { }
+
+std::uint64_t TimerWheel::ticksAt(Clock::time_point time) const {
+    if (time <= start_)
+        return 0;
+    return static_cast<std::uint64_t>((time - start_) / tick_);
+}
+
+void TimerWheel::schedule(Clock::time_point now, Clock::duration delay, Callback callback) {
+    // Пустое колесо не нужно прокручивать тик за тиком до текущего времени.
+    if (size_ == 0)
+        current_ = std::max(current_, ticksAt(now));
+
+    auto ticks = static_cast<std::uint64_t>((std::max(delay, Clock::duration::zero()) + tick_ - Clock::duration{1}) / tick_);
+    auto expiry = std::max(ticksAt(now) + ticks, current_ + 1);
+    std::vector<Callback> expired;
+    insert(Timer{expiry, std::move(callback)}, expired);
+    ++size_;
+}
+
+void TimerWheel::insert(Timer&& timer, std::vector<Callback>& expired) {
+    if (timer.expiry <= current_) {
+        expired.push_back(std::move(timer.callback));
+        return;
+    }
+    constexpr std::uint64_t span = std::uint64_t{1} << (slotBits * levels);
+    timer.expiry = std::min(timer.expiry, current_ + span - 1);
+    auto delta = timer.expiry - current_;
+    unsigned level = 0;
+    while (level + 1 < levels && delta >= (std::uint64_t{1} << (slotBits * (level + 1))))
+        ++level;
+    auto slot = (timer.expiry >> (slotBits * level)) & slotMask;
+    wheel_[level][slot].push_back(std::move(timer));
+}
+
+void TimerWheel::cascade(unsigned level, std::vector<Callback>& expired) {
+    auto slot = (current_ >> (slotBits * level)) & slotMask;
+    auto timers = std::move(wheel_[level][slot]);
+    wheel_[level][slot].clear();
+    for (auto& timer: timers)
+        insert(std::move(timer), expired);
+}
+
+std::vector<TimerWheel::Callback> TimerWheel::advance(Clock::time_point now) {
+    std::vector<Callback> expired;
+    auto target = ticksAt(now);
+    if (size_ == 0) {
+        current_ = std::max(current_, target);
+        return expired;
+    }
+    while (current_ < target && expired.size() < size_) {
+        ++current_;
+        for (unsigned level = 1; level < levels; ++level) {
+            if ((current_ & ((std::uint64_t{1} << (slotBits * level)) - 1)) != 0)
+                break;
+            cascade(level, expired);
+        }
+        auto& slot = wheel_[0][current_ & slotMask];
+        for (auto& timer: slot)
+            expired.push_back(std::move(timer.callback));
+        slot.clear();
+    }
+    size_ -= expired.size();
+    if (size_ == 0)
+        current_ = std::max(current_, target);
+    return expired;
+}
+
+TimerWheel::Clock::time_point TimerWheel::nextExpiry() const {
+    if (size_ == 0)
+        return Clock::time_point::max();
+    // Ближайший непустой слот нулевого уровня до следующего перераспределения.
+    auto boundary = (current_ | slotMask) + 1;
+    for (auto tick = current_ + 1; tick < boundary; ++tick) {
+        if (!wheel_[0][tick & slotMask].empty())
+            return start_ + tick_ * static_cast<Clock::rep>(tick);
+    }
+    return start_ + tick_ * static_cast<Clock::rep>(boundary);
+}
+
+bool TimerWheel::empty() const {
+    return size_ == 0;
+}
+
+std::size_t TimerWheel::size() const {
+    return size_;
+}
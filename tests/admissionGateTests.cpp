@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "admissionGate.hpp"
+
+TEST(AdmissionGateTest, RejectsAboveLimitUntilLeave) {
+    TP::AdmissionGate gate;
+    EXPECT_TRUE(gate.tryEnter(2));
+    EXPECT_TRUE(gate.tryEnter(2));
+    EXPECT_FALSE(gate.tryEnter(2));
+    EXPECT_EQ(gate.inFlight(), 2);
+
+    gate.leave();
+    EXPECT_TRUE(gate.tryEnter(2));
+    // Уменьшенный предел сразу отклоняет новые вызовы, допущенные ранее продолжают работу.
+    EXPECT_FALSE(gate.tryEnter(1));
+    EXPECT_EQ(gate.inFlight(), 2);
+}
+
+TEST(AdmissionGateTest, NeverAdmitsMoreThanLimitConcurrently) {
+    TP::AdmissionGate gate;
+    constexpr std::size_t limit = 8;
+    constexpr int threads = 8;
+    std::atomic<std::size_t> maxSeen{0};
+    std::atomic<int> admitted{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+        workers.emplace_back([&]() {
+            for (int i = 0; i < 20000; ++i) {
+                if (!gate.tryEnter(limit))
+                    continue;
+                ++admitted;
+                auto seen = gate.inFlight();
+                auto previous = maxSeen.load();
+                while (seen > previous && !maxSeen.compare_exchange_weak(previous, seen)) {}
+                gate.leave();
+            }
+        });
+    for (auto& worker: workers)
+        worker.join();
+    EXPECT_GT(admitted.load(), 0);
+    EXPECT_LE(maxSeen.load(), limit);
+    EXPECT_EQ(gate.inFlight(), 0);
+}
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <thread>
+#include <unordered_set>
+#include "callIdGenerator.hpp"
+
+TEST(CallIdGeneratorTest, EncodesNodeAndTimestamp) {
+    TP::CallIdGenerator generator(517);
+    auto before = std::chrono::system_clock::now();
+    auto id = generator.next();
+    auto after = std::chrono::system_clock::now();
+
+    EXPECT_EQ(TP::CallIdGenerator::node(id), 517);
+    EXPECT_GE(TP::CallIdGenerator::timestamp(id), before - std::chrono::milliseconds{1});
+    EXPECT_LE(TP::CallIdGenerator::timestamp(id), after);
+}
+
+TEST(CallIdGeneratorTest, DifferentNodesNeverCollide) {
+    TP::CallIdGenerator first(1), second(2);
+    std::unordered_set<TP::CallID> ids;
+    for (int i = 0; i < 10000; ++i) {
+        EXPECT_TRUE(ids.insert(first.next()).second);
+        EXPECT_TRUE(ids.insert(second.next()).second);
+    }
+}
+
+TEST(CallIdGeneratorTest, UniqueAndMonotonicAcrossThreads) {
+    TP::CallIdGenerator generator(3);
+    constexpr int threads = 4;
+    constexpr int perThread = 50000; // Больше 4096 за миллисекунду, номер переходит в следующие миллисекунды.
+    std::vector<std::vector<TP::CallID>> ids(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+        workers.emplace_back([&generator, &ids, t]() {
+            ids[t].reserve(perThread);
+            for (int i = 0; i < perThread; ++i)
+                ids[t].push_back(generator.next());
+        });
+    for (auto& worker: workers)
+        worker.join();
+
+    std::vector<TP::CallID> all;
+    for (const auto& threadIds: ids) {
+        EXPECT_TRUE(std::is_sorted(threadIds.begin(), threadIds.end()));
+        all.insert(all.end(), threadIds.begin(), threadIds.end());
+    }
+    std::sort(all.begin(), all.end());
+    EXPECT_EQ(std::adjacent_find(all.begin(), all.end()), all.end());
+}
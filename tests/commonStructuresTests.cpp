@@ -1,4 +1,6 @@
 #include "commonStructures.hpp"
+#include "cdrFormatter.hpp"
+#include <array>
 #include <fstream>
 #include <gtest/gtest.h>
 #include <regex>
@@ -75,4 +77,50 @@ TEST(CommonStructures, CorrectlyWritesCDRToOfstreamWhenTimeout) {
     EXPECT_EQ(content, expectedContent);
 
     std::remove("test_output.txt");
-}
\ No newline at end of file
+}
+TEST(CommonStructures, CdrFormatterMatchesPrepareTime) {
+    utility::CdrFormatter formatter;
+    auto time = std::chrono::system_clock::from_time_t(std::time_t{1701775845});
+    std::array<char, 32> buffer{};
+    for (auto offset: {0, 7, 999, 1000, 1001, 59999, 86400123}) {
+        auto timePoint = time + std::chrono::milliseconds{offset};
+        auto* end = formatter.formatTime(buffer.data(), buffer.data() + buffer.size(), timePoint);
+        ASSERT_NE(end, nullptr);
+        EXPECT_EQ(std::string(buffer.data(), end), utility::prepareTime(timePoint));
+    }
+    EXPECT_EQ(formatter.formatTime(buffer.data(), buffer.data() + buffer.size(), {}), buffer.data());
+}
+
+TEST(CommonStructures, CdrFormatterReportsShortBuffer) {
+    CDR cdr{};
+    cdr.startTime = std::chrono::system_clock::now();
+    cdr.number = "89001234567";
+    cdr.status = CallStatus::Overloaded;
+
+    utility::CdrFormatter formatter;
+    std::vector<char> buffer(utility::CdrFormatter::maxSize(cdr));
+    auto* end = formatter.format(buffer.data(), buffer.data() + buffer.size(), cdr);
+    ASSERT_NE(end, nullptr);
+    std::string record;
+    utility::appendCDR(record, cdr);
+    EXPECT_EQ(std::string(buffer.data(), end), record);
+    EXPECT_EQ(formatter.format(buffer.data(), buffer.data() + 20, cdr), nullptr);
+}
+
+TEST(CommonStructures, CallerNumberOwnsItsDigits) {
+    std::string source = "890012345678901";
+    utility::CallerNumber number = source;
+    source.assign(source.size(), '0');
+    EXPECT_EQ(number.view(), "890012345678901");
+    EXPECT_EQ(number.size(), utility::CallerNumber::maxLength);
+
+    EXPECT_EQ(utility::CallerNumber("8900"), utility::CallerNumber(std::string_view{"89001", 4}));
+    EXPECT_FALSE(utility::CallerNumber("8900") == utility::CallerNumber("89000"));
+    EXPECT_FALSE(utility::CallerNumber("") == utility::CallerNumber("0"));
+    EXPECT_EQ(utility::CallerNumber("8900").hash(), std::hash<utility::CallerNumber>{}(utility::CallerNumber("8900")));
+
+    EXPECT_TRUE(utility::CallerNumber::valid("890012345678901"));
+    EXPECT_FALSE(utility::CallerNumber::valid("8900123456789012"));
+    EXPECT_FALSE(utility::CallerNumber::valid(""));
+    EXPECT_THROW(utility::CallerNumber("8900123456789012"), std::length_error);
+}
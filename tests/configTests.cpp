@@ -4,12 +4,16 @@
 #include "config.hpp"
 #include "threadpool.hpp"
 
+#include <fstream>
+#include <future>
+
 class MockManager : public IManager {
 public:
     MockManager(std::shared_ptr<utility::IConfig> conf, std::shared_ptr<TP::IThreadPool> pool)
         : IManager(conf, pool) {}
 
     MOCK_METHOD((std::pair<TP::CallID, std::future<Result>>), addTask, (std::string_view number), (override));
+    MOCK_METHOD(TP::CallID, addTask, (std::string_view number, TP::CompletionHandler handler), (override));
     MOCK_METHOD(void, startThreadPool, (), (override));
     MOCK_METHOD(void, stopThreadPool, (), (override));
     MOCK_METHOD(void, setNewConfig,(std::shared_ptr<utility::IConfig> config), (override));
@@ -66,6 +70,24 @@ TEST_F(ThreadSafeConfigTest, GetSizeOfQueue) {
     ASSERT_EQ(result, expectedSizeOfQueue);
 }
 
+TEST_F(ThreadSafeConfigTest, HttpSettingsDefaultsWhenAbsent) {
+    ASSERT_EQ(config->getKeepAliveTimeout(), 30);
+    ASSERT_EQ(config->getMaxRequestsPerConnection(), 1000);
+}
+
+TEST_F(ThreadSafeConfigTest, QueueTypeDefaultsWhenAbsent) {
+    ASSERT_EQ(config->getQueueType(), 0);
+}
+
+TEST_F(ThreadSafeConfigTest, NodeIDDefaultsWhenAbsent) {
+    ASSERT_EQ(config->getNodeID(), 0);
+}
+
+TEST_F(ThreadSafeConfigTest, LogSettingsDefaultsWhenAbsent) {
+    ASSERT_EQ(config->getLogLevel(), spdlog::level::debug);
+    ASSERT_EQ(config->getLogOverflowPolicy(), 0);
+}
+
 TEST_F(ThreadSafeConfigTest, Notify) {
     EXPECT_CALL(*mockManager, update()).Times(1);
     config->notify();
@@ -100,6 +122,17 @@ TEST_F(ThreadSafeConfigTest, GetSizeOfQueueUpdate) {
     ASSERT_EQ(result, expectedOperators);
 }
 
+TEST_F(ThreadSafeConfigTest, SnapshotIsImmutableAfterUpdate) {
+    config = std::make_shared<utility::ThreadSafeConfig>("upperBorder.json", nullptr);
+    auto before = config->getSnapshot();
+    config->updateConfig();
+    auto after = config->getSnapshot();
+    ASSERT_NE(before, after);
+    ASSERT_EQ(before->amountOfOperators, 10000);
+    ASSERT_EQ(after->amountOfOperators, 80);
+    ASSERT_EQ(after->sizeOfQueue, config->getSizeOfQueue());
+}
+
 TEST_F(ThreadSafeConfigTest, IsUpdatedWithoutUpdate) {
     auto result = config->isUpdated();
     ASSERT_TRUE(!result);
@@ -137,6 +170,20 @@ TEST_F(ThreadSafeConfigTest, GetSizeOfQueueUpdateTestUpperBorder) {
     ASSERT_EQ(result, expectedSizeOfQueue);
 }
 
+TEST_F(ThreadSafeConfigTest, HttpSettingsUpdateTestUpperBorder) {
+    config = std::make_shared<utility::ThreadSafeConfig>("upperBorder.json", nullptr);
+    config->updateConfig();
+    ASSERT_EQ(config->getKeepAliveTimeout(), 3600);
+    ASSERT_EQ(config->getMaxRequestsPerConnection(), 100000);
+}
+
+TEST_F(ThreadSafeConfigTest, HttpSettingsUpdateTestLowerBorder) {
+    config = std::make_shared<utility::ThreadSafeConfig>("lowerBorder.json", nullptr);
+    config->updateConfig();
+    ASSERT_EQ(config->getKeepAliveTimeout(), 30);
+    ASSERT_EQ(config->getMaxRequestsPerConnection(), 1000);
+}
+
 TEST_F(ThreadSafeConfigTest, GetMinMaxUpdateTestLowereBorder) {
     config = std::make_shared<utility::ThreadSafeConfig>("lowerBorder.json", nullptr);
     config->updateConfig();
@@ -200,3 +247,79 @@ TEST_F(ThreadSafeConfigTest, RunMonitoringStartsThread) {
     std::this_thread::sleep_for(std::chrono::seconds(1));
     ASSERT_TRUE(configUpdateThread->isMonitoring());
 }
+
+TEST_F(ThreadSafeConfigTest, ReloadsAfterAtomicReplaceAndStopsPromptly) {
+    auto directory = std::filesystem::temp_directory_path() / "protei_cov_config_watch";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    std::filesystem::copy_file("base.json", directory / "base.json");
+
+    auto watched = std::make_shared<utility::ThreadSafeConfig>(directory / "base.json", nullptr);
+    std::promise<void> updated;
+    EXPECT_CALL(*mockManager, update()).WillOnce([&updated] { updated.set_value(); });
+    watched->setManager(mockManager);
+    watched->RunMonitoring();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    {
+        std::ofstream out(directory / "base.json.tmp");
+        out << R"({"RMin": 10, "RMax": 15, "AmountOfOperators": 7, "SizeOfQueue": 15})";
+    }
+    std::filesystem::rename(directory / "base.json.tmp", directory / "base.json");
+
+    ASSERT_EQ(updated.get_future().wait_for(std::chrono::seconds(2)), std::future_status::ready);
+    ASSERT_EQ(watched->getAmountOfOperators(), 7);
+
+    auto start = std::chrono::steady_clock::now();
+    watched->stopMonitoring();
+    ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+    ASSERT_FALSE(watched->isMonitoring());
+    std::filesystem::remove_all(directory);
+}
+
+TEST_F(ThreadSafeConfigTest, PriorityClassesFromNestedObject) {
+    auto path = std::filesystem::temp_directory_path() / "protei_cov_priority.json";
+    {
+        std::ofstream out(path);
+        out << R"({"RMin": 10, "RMax": 15, "AmountOfOperators": 5, "SizeOfQueue": 15,
+                   "PriorityPrefixes": {"112": 2, "8800": 1, "12a": 1, "7": 9}, "PriorityWeightVip": 0})";
+    }
+    auto priorityConfig = std::make_shared<utility::ThreadSafeConfig>(path, nullptr);
+    auto snapshot = priorityConfig->getSnapshot();
+    std::map<std::string, int> expected{{"112", 2}, {"7", 2}, {"8800", 1}};
+    EXPECT_EQ(snapshot->priorityPrefixes, expected);
+    EXPECT_EQ(snapshot->priorityWeightNormal, 1);
+    EXPECT_EQ(snapshot->priorityWeightVip, 4);
+    EXPECT_EQ(snapshot->priorityWeightEmergency, 16);
+    std::filesystem::remove(path);
+}
+
+TEST_F(ThreadSafeConfigTest, NumberFilterFromNestedObject) {
+    auto path = std::filesystem::temp_directory_path() / "protei_cov_number_filter.json";
+    {
+        std::ofstream out(path);
+        out << R"({"RMin": 10, "RMax": 15, "AmountOfOperators": 5, "SizeOfQueue": 15,
+                   "NumberFilter": {"7495": 0, "7495123": 1, "8x": 0, "7812": 5}})";
+    }
+    auto filterConfig = std::make_shared<utility::ThreadSafeConfig>(path, nullptr);
+    auto snapshot = filterConfig->getSnapshot();
+    EXPECT_EQ(snapshot->numberFilterMode, 0);
+    ASSERT_NE(snapshot->numberFilter, nullptr);
+    EXPECT_TRUE(snapshot->rejects("74951112233"));
+    EXPECT_FALSE(snapshot->rejects("74951231122"));
+    EXPECT_FALSE(snapshot->rejects("78121112233"));
+    EXPECT_FALSE(snapshot->rejects("89001112233"));
+    EXPECT_EQ(config->getSnapshot()->numberFilter, nullptr);
+    EXPECT_FALSE(config->getSnapshot()->rejects("74951112233"));
+
+    {
+        std::ofstream out(path);
+        out << R"({"RMin": 10, "RMax": 15, "AmountOfOperators": 5, "SizeOfQueue": 15,
+                   "NumberFilterMode": 1, "NumberFilter": {"7495": 1}})";
+    }
+    filterConfig = std::make_shared<utility::ThreadSafeConfig>(path, nullptr);
+    snapshot = filterConfig->getSnapshot();
+    EXPECT_FALSE(snapshot->rejects("74951112233"));
+    EXPECT_TRUE(snapshot->rejects("89001112233"));
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "durationGenerator.hpp"
+
+namespace {
+double averageOf(const TP::DurationGenerator& generator, int count) {
+    double sum = 0;
+    for (int i = 0; i < count; ++i)
+        sum += static_cast<double>(generator.next().count());
+    return sum / count;
+}
+}
+
+TEST(DurationGeneratorTest, UniformCoversWholeRange) {
+    TP::DurationGenerator generator(TP::DurationDistribution::Uniform, 4, 8);
+    std::vector<int> hits(9, 0);
+    for (int i = 0; i < 10000; ++i) {
+        auto value = generator.next().count();
+        ASSERT_GE(value, 4);
+        ASSERT_LE(value, 8);
+        ++hits[value];
+    }
+    for (int value = 4; value <= 8; ++value)
+        EXPECT_GT(hits[value], 1500);
+}
+
+TEST(DurationGeneratorTest, SeededSequenceRepeats) {
+    TP::DurationGenerator first(TP::DurationDistribution::LogNormal, 5, 140, 30, 0.8, 42);
+    TP::DurationGenerator second(TP::DurationDistribution::LogNormal, 5, 140, 30, 0.8, 42);
+    TP::DurationGenerator other(TP::DurationDistribution::LogNormal, 5, 140, 30, 0.8, 43);
+    std::vector<long> a, b, c;
+    for (int i = 0; i < 1000; ++i) {
+        a.push_back(first.next().count());
+        b.push_back(second.next().count());
+        c.push_back(other.next().count());
+    }
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+}
+
+TEST(DurationGeneratorTest, SeededSequenceDoesNotDependOnThreads) {
+    constexpr int threads = 4;
+    constexpr int perThread = 2000;
+    TP::DurationGenerator sequential(TP::DurationDistribution::Uniform, 5, 140, 0, 0.5, 7);
+    std::vector<int> expected(141, 0);
+    for (int i = 0; i < threads * perThread; ++i)
+        ++expected[sequential.next().count()];
+
+    TP::DurationGenerator shared(TP::DurationDistribution::Uniform, 5, 140, 0, 0.5, 7);
+    std::vector<std::vector<int>> counts(threads, std::vector<int>(141, 0));
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+        workers.emplace_back([&shared, &counts, t]() {
+            for (int i = 0; i < perThread; ++i)
+                ++counts[t][shared.next().count()];
+        });
+    for (auto& worker: workers)
+        worker.join();
+    for (int value = 0; value <= 140; ++value) {
+        int total = 0;
+        for (const auto& count: counts)
+            total += count[value];
+        EXPECT_EQ(total, expected[value]);
+    }
+}
+
+TEST(DurationGeneratorTest, ServiceTimeDistributionsKeepMeanAndBounds) {
+    TP::DurationGenerator exponential(TP::DurationDistribution::Exponential, 5, 140, 20, 0.5, 1);
+    TP::DurationGenerator logNormal(TP::DurationDistribution::LogNormal, 5, 140, 20, 0.5, 2);
+    EXPECT_NEAR(averageOf(exponential, 50000), 20.0, 2.0);
+    EXPECT_NEAR(averageOf(logNormal, 50000), 20.0, 1.0);
+
+    TP::DurationGenerator clamped(TP::DurationDistribution::Exponential, 10, 12, 100);
+    for (int i = 0; i < 1000; ++i) {
+        auto value = clamped.next().count();
+        ASSERT_GE(value, 10);
+        ASSERT_LE(value, 12);
+    }
+}
+
+TEST(DurationGeneratorTest, BuildsFromSnapshot) {
+    utility::ConfigSnapshot snapshot;
+    snapshot.rMin = 10;
+    snapshot.rMax = 15;
+    snapshot.durationDistribution = 1;
+    snapshot.durationSigma = 50;
+    snapshot.durationSeed = 5;
+    auto generator = TP::DurationGenerator::fromSnapshot(snapshot);
+    EXPECT_EQ(generator->distribution(), TP::DurationDistribution::Exponential);
+    TP::DurationGenerator expected(TP::DurationDistribution::Exponential, 10, 15, 0, 0.5, 5);
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(generator->next(), expected.next());
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "callMetrics.hpp"
+#include "latencyHistogram.hpp"
+
+using utility::LatencyHistogram;
+
+TEST(LatencyHistogramTest, BucketsKeepRelativeErrorBelowOneSixteenth) {
+    for (std::uint64_t value: {0ull, 1ull, 15ull, 16ull, 17ull, 31ull, 32ull, 1000ull, 123456ull, 987654321ull}) {
+        auto index = LatencyHistogram::bucketIndex(value);
+        auto upper = LatencyHistogram::bucketUpperBound(index);
+        EXPECT_GE(upper, value);
+        EXPECT_LE(upper - value, value / 16);
+        if (index > 0) {
+            EXPECT_LT(LatencyHistogram::bucketUpperBound(index - 1), value);
+        }
+    }
+    EXPECT_EQ(LatencyHistogram::bucketIndex(~std::uint64_t{0}), LatencyHistogram::bucketCount - 1);
+}
+
+TEST(LatencyHistogramTest, PercentilesMergeAllThreads) {
+    auto histogram = std::make_unique<LatencyHistogram>();
+    constexpr int threads = 4;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+        workers.emplace_back([&histogram]() {
+            for (int i = 1; i <= 1000; ++i)
+                histogram->record(std::chrono::milliseconds{i});
+        });
+    for (auto& worker: workers)
+        worker.join();
+
+    auto snapshot = histogram->snapshot();
+    ASSERT_EQ(snapshot.count, threads * 1000u);
+    EXPECT_EQ(snapshot.sum, threads * 500500u * 1000u);
+    auto p50 = snapshot.percentile(50).count();
+    auto p99 = snapshot.percentile(99).count();
+    EXPECT_GE(p50, 500000);
+    EXPECT_LE(p50, 500000 + 500000 / 16);
+    EXPECT_GE(p99, 990000);
+    EXPECT_LE(p99, 990000 + 990000 / 16);
+    EXPECT_EQ(snapshot.countAtMost((1u << 19) - 1), threads * 524u);
+}
+
+TEST(CallMetricsTest, RecordsLifecycleFromCdr) {
+    auto metrics = std::make_shared<utility::CallMetrics>();
+    auto start = std::chrono::system_clock::now();
+
+    CDR served{};
+    served.status = CallStatus::Completed;
+    served.startTime = start;
+    served.operatorCallTime = start + std::chrono::milliseconds{3};
+    served.endTime = served.operatorCallTime + std::chrono::seconds{2};
+    metrics->makeRecord(served);
+
+    CDR rejected{};
+    rejected.status = CallStatus::Overloaded;
+    rejected.startTime = rejected.operatorCallTime = rejected.endTime = start;
+    metrics->makeRecord(rejected);
+
+    EXPECT_EQ(metrics->queueWait().snapshot().count, 1u);
+    EXPECT_EQ(metrics->service().snapshot().percentile(100), std::chrono::microseconds{
+        LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketIndex(2000000))});
+
+    auto text = metrics->prometheus();
+    EXPECT_NE(text.find("# TYPE protei_cov_queue_wait_seconds histogram"), std::string::npos);
+    EXPECT_NE(text.find("protei_cov_queue_wait_seconds_bucket{le=\"0.004096\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("protei_cov_queue_wait_seconds_bucket{le=\"0.002048\"} 0\n"), std::string::npos);
+    EXPECT_NE(text.find("protei_cov_call_seconds_count 1\n"), std::string::npos);
+    EXPECT_NE(text.find("protei_cov_calls_total{status=\"Completed\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("protei_cov_calls_total{status=\"Overloaded\"} 1\n"), std::string::npos);
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <optional>
+#include <thread>
+#include "threadpool.hpp"
+#include "lockFreeQueue.hpp"
+#include "task.hpp"
+
+TEST(LockFreeQueueTest, PushTryPopKeepsOrder) {
+    TP::LockFreeQueue queue(3);
+    std::chrono::system_clock::time_point time;
+    std::shared_ptr<spdlog::logger> logger = nullptr;
+    auto task1 = std::make_shared<TP::Task>(1, 2, "1", time, logger);
+    auto task2 = std::make_shared<TP::Task>(1, 2, "2", time, logger);
+    auto task3 = std::make_shared<TP::Task>(1, 2, "3", time, logger);
+
+    EXPECT_TRUE(queue.push(std::make_pair(task1, 1)));
+    EXPECT_TRUE(queue.push(std::make_pair(task2, 2)));
+    EXPECT_TRUE(queue.push(std::make_pair(task3, 3)));
+    EXPECT_FALSE(queue.empty());
+
+    std::pair<std::shared_ptr<TP::ITask>, TP::CallID> taskPair;
+    ASSERT_TRUE(queue.tryPop(taskPair));
+    EXPECT_EQ(taskPair.first, task1);
+    ASSERT_TRUE(queue.tryPop(taskPair));
+    EXPECT_EQ(taskPair.first, task2);
+    ASSERT_TRUE(queue.tryPop(taskPair));
+    EXPECT_EQ(taskPair.first, task3);
+    EXPECT_FALSE(queue.tryPop(taskPair));
+    EXPECT_TRUE(queue.empty());
+    EXPECT_TRUE(queue.isLockFree());
+}
+
+TEST(LockFreeQueueTest, Overloaded) {
+    TP::LockFreeQueue queue(2);
+    std::chrono::system_clock::time_point time;
+    std::shared_ptr<spdlog::logger> logger = nullptr;
+    auto task1 = std::make_shared<TP::Task>(1, 2, "1", time, logger);
+    auto task2 = std::make_shared<TP::Task>(1, 2, "2", time, logger);
+    auto task3 = std::make_shared<TP::Task>(1, 2, "3", time, logger);
+
+    EXPECT_TRUE(queue.push(std::make_pair(task1, 1)));
+    EXPECT_TRUE(queue.push(std::make_pair(task2, 2)));
+    EXPECT_FALSE(queue.push(std::make_pair(task3, 3)));
+    EXPECT_EQ(task3->promise_->get_future().get().status, CallStatus::Overloaded);
+}
+
+TEST(LockFreeQueueTest, DuplicationMovesCallToBack) {
+    TP::LockFreeQueue queue(3);
+    std::chrono::system_clock::time_point time;
+    std::shared_ptr<spdlog::logger> logger = nullptr;
+    auto task1 = std::make_shared<TP::Task>(1, 2, "1", time, logger);
+    auto task2 = std::make_shared<TP::Task>(1, 2, "2", time, logger);
+    auto task3 = std::make_shared<TP::Task>(1, 2, "1", time, logger);
+    std::optional<Result> result;
+    task1->addCompletionHandler([&result](std::exception_ptr exception, Result r) {
+        EXPECT_FALSE(exception);
+        result = r;
+    });
+    TP::CallID id = 1;
+    task1->setCallID(id);
+
+    EXPECT_TRUE(queue.push(std::make_pair(task1, 1)));
+    EXPECT_TRUE(queue.push(std::make_pair(task2, 2)));
+    EXPECT_TRUE(queue.push(std::make_pair(task3, 3)));
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->status, CallStatus::Duplication);
+    EXPECT_EQ(result->callID, 1);
+
+    std::pair<std::shared_ptr<TP::ITask>, TP::CallID> taskPair;
+    ASSERT_TRUE(queue.tryPop(taskPair));
+    EXPECT_EQ(taskPair.first, task2);
+    ASSERT_TRUE(queue.tryPop(taskPair));
+    EXPECT_EQ(taskPair.first, task3);
+    EXPECT_FALSE(queue.tryPop(taskPair));
+}
+
+TEST(LockFreeQueueTest, ConcurrentProducersAndConsumers) {
+    constexpr int producers = 4;
+    constexpr int tasksPerProducer = 500;
+    TP::LockFreeQueue queue(producers * tasksPerProducer);
+    std::chrono::system_clock::time_point time;
+    std::shared_ptr<spdlog::logger> logger = nullptr;
+    std::vector<std::string> numbers;
+    for (int i = 0; i < producers * tasksPerProducer; ++i)
+        numbers.push_back(std::to_string(i));
+
+    std::atomic<int> popped{0};
+    std::atomic<bool> done{false};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < tasksPerProducer; ++i) {
+                auto index = p * tasksPerProducer + i;
+                auto task = std::make_shared<TP::Task>(1, 2, numbers[index], time, logger);
+                EXPECT_TRUE(queue.push(std::make_pair(task, index)));
+            }
+        });
+    }
+    for (int c = 0; c < 2; ++c) {
+        threads.emplace_back([&] {
+            std::pair<std::shared_ptr<TP::ITask>, TP::CallID> taskPair;
+            while (!done || !queue.empty()) {
+                if (queue.tryPop(taskPair))
+                    ++popped;
+            }
+        });
+    }
+    for (int p = 0; p < producers; ++p)
+        threads[p].join();
+    done = true;
+    for (std::size_t t = producers; t < threads.size(); ++t)
+        threads[t].join();
+
+    EXPECT_EQ(popped, producers * tasksPerProducer);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(LockFreeQueueTest, ThreadPoolProcessesTasks) {
+    auto time = std::chrono::system_clock::now();
+    std::shared_ptr<spdlog::logger> logger = nullptr;
+    auto pool = std::make_shared<TP::ThreadPool>(2, 16);
+    pool->setTaskQueue(std::make_shared<TP::LockFreeQueue>(16));
+    pool->start();
+
+    std::vector<std::string> numbers;
+    for (int i = 1; i <= 8; ++i)
+        numbers.push_back(std::to_string(i));
+    std::vector<std::future<Result>> futures;
+    for (const auto& number: numbers) {
+        auto task = std::make_shared<TP::Task>(1, 2, number, time, logger);
+        futures.push_back(pool->add_task(task).second);
+    }
+    for (auto& future: futures)
+        EXPECT_EQ(future.get().status, CallStatus::Completed);
+}
@@ -3,7 +3,9 @@
 #include "manager.hpp"
 
 #include "interfaces.hpp"
+#include "task.hpp"
 #include "threadpool.hpp"
+#include <optional>
 
 class MockQueue : public TP::IQueue {
 public:
@@ -13,10 +15,15 @@ public:
     MOCK_METHOD(bool, empty, (), (const, override));
     MOCK_METHOD(bool, push, ((std::pair<std::shared_ptr<TP::ITask>, TP::CallID>&& taskPair)), (override));
     MOCK_METHOD(void, pop, (), (override));
+    MOCK_METHOD(bool, tryPop, ((std::pair<std::shared_ptr<TP::ITask>, TP::CallID>& taskPair)), (override));
+    MOCK_METHOD(bool, tryPop, ((std::pair<std::shared_ptr<TP::ITask>, TP::CallID>& taskPair), std::size_t worker), (override));
+    MOCK_METHOD(bool, isLockFree, (), (const, override));
     MOCK_METHOD(void, update, (int size), (override));
     MOCK_METHOD(void, setLogger, ((std::shared_ptr<spdlog::logger>)), (override));
     MOCK_METHOD(void, setRecorders, ((std::vector<std::shared_ptr<IRecorder>> recorders)), (override));
     MOCK_METHOD(void, writeCDR, (const CDR& cdr), (override));
+    MOCK_METHOD(std::size_t, expire, (std::chrono::system_clock::time_point now), (override));
+    MOCK_METHOD(std::chrono::system_clock::time_point, nextDeadline, (), (const, override));
 };
 
 class MockConfig : public utility::IConfig {
@@ -25,7 +32,18 @@ public:
     MOCK_METHOD((std::pair<int, int>), getMinMax, (), (override));
     MOCK_METHOD(int, getAmountOfOperators, (), (override));
     MOCK_METHOD(int, getSizeOfQueue, (), (override));
+    MOCK_METHOD(int, getKeepAliveTimeout, (), (override));
+    MOCK_METHOD(int, getMaxRequestsPerConnection, (), (override));
+    MOCK_METHOD(int, getQueueType, (), (override));
+    MOCK_METHOD(int, getOperatorMode, (), (override));
+    MOCK_METHOD(int, getCdrDurability, (), (override));
+    MOCK_METHOD(int, getCdrFlushInterval, (), (override));
+    MOCK_METHOD(int, getCdrBatchSize, (), (override));
+    MOCK_METHOD(int, getNodeID, (), (override));
+    MOCK_METHOD(int, getLogLevel, (), (override));
+    MOCK_METHOD(int, getLogOverflowPolicy, (), (override));
     MOCK_METHOD(std::filesystem::path, getPath, (), (override));
+    MOCK_METHOD(std::shared_ptr<const utility::ConfigSnapshot>, getSnapshot, (), (override));
     MOCK_METHOD(void, updateConfig, (), (override));
     MOCK_METHOD(bool, isUpdated, (), (override));
     MOCK_METHOD(void, notify, (), (override));
@@ -36,6 +54,16 @@ public:
     MOCK_METHOD(void, normalizeRMinRMax,(), (override));
     MOCK_METHOD(void, normalizeAmountOfOperators,(), (override));
     MOCK_METHOD(void, normalizeSizeOfQueue,(), (override));
+    MOCK_METHOD(void, normalizeHttpSettings,(), (override));
+    MOCK_METHOD(void, normalizeQueueType,(), (override));
+    MOCK_METHOD(void, normalizeQueueDiscipline,(), (override));
+    MOCK_METHOD(void, normalizePriorityClasses,(), (override));
+    MOCK_METHOD(void, normalizeNumberFilter,(), (override));
+    MOCK_METHOD(void, normalizeOperatorMode,(), (override));
+    MOCK_METHOD(void, normalizeCdrSettings,(), (override));
+    MOCK_METHOD(void, normalizeNodeID,(), (override));
+    MOCK_METHOD(void, normalizeLogSettings,(), (override));
+    MOCK_METHOD(void, normalizeDurationSettings,(), (override));
 };
 
 // Mock для IThreadPool
@@ -44,18 +72,31 @@ public:
     MockThreadPool(unsigned amountOfThreads, unsigned sizeOfQueue) : TP::IThreadPool(amountOfThreads, sizeOfQueue) {}
 
     MOCK_METHOD((std::pair<TP::CallID, std::future<Result>>), add_task, (std::shared_ptr<TP::ITask> task), (override));
+    MOCK_METHOD(TP::CallID, add_task, (std::shared_ptr<TP::ITask> task, TP::CompletionHandler handler), (override));
     MOCK_METHOD(void, stop, (), (override));
     MOCK_METHOD(void, start, (), (override));
     MOCK_METHOD(void, transferObjects, (const std::shared_ptr<TP::IThreadPool>& oldThreadPool), (override));
+    MOCK_METHOD(void, resize, (unsigned amountOfOperators), (override));
     MOCK_METHOD(void, setTaskQueue, (std::shared_ptr<TP::IQueue> task_queue), (override));
     MOCK_METHOD(void, setLogger, ((std::shared_ptr<spdlog::logger>)), (override));
     MOCK_METHOD((std::size_t), getSize, (), (override));
+    MOCK_METHOD(TP::CallID, reject, (std::shared_ptr<TP::ITask> task, CallStatus status), (override));
 };
 
+std::shared_ptr<const utility::ConfigSnapshot> makeSnapshot(int amountOfOperators) {
+    auto snapshot = std::make_shared<utility::ConfigSnapshot>();
+    snapshot->rMin = 10;
+    snapshot->rMax = 20;
+    snapshot->amountOfOperators = amountOfOperators;
+    snapshot->sizeOfQueue = 4;
+    return snapshot;
+}
+
 class ManagerTest : public testing::Test {
 protected:
     void SetUp() override {
         mockConfig = std::make_shared<MockConfig>("base.json", nullptr);
+        ON_CALL(*mockConfig, getSnapshot()).WillByDefault(::testing::Return(makeSnapshot(2)));
         mockThreadPool = std::make_shared<MockThreadPool>(2, 4);
         mockQueue = std::make_shared<MockQueue>(4);
         mockThreadPool->setTaskQueue(mockQueue);
@@ -75,7 +116,7 @@ protected:
 
 //Тест конструктора Manager
 TEST_F(ManagerTest, ConstructorTest) {
-    EXPECT_CALL(*mockConfig, getMinMax()).WillOnce(::testing::Return(std::make_pair(10,20)));
+    EXPECT_CALL(*mockConfig, getSnapshot()).WillOnce(::testing::Return(makeSnapshot(2)));
     auto mockThreadPool1 = std::make_shared<MockThreadPool>(2, 4);
     auto manager1 = std::make_shared<Manager>(mockConfig, mockThreadPool1);
 
@@ -105,10 +146,49 @@ TEST_F(ManagerTest, AddTaskTest) {
     manager->addTask("test_num");
 }
 
+TEST_F(ManagerTest, AddTaskWithHandlerTest) {
+    EXPECT_CALL(*mockThreadPool, add_task(::testing::_, ::testing::_)).WillOnce(::testing::Return(10));
+    auto callID = manager->addTask("test_num", [](std::exception_ptr, Result) { });
+    ASSERT_EQ(callID, 10);
+}
+
+TEST_F(ManagerTest, FilteredNumberRejectedWithoutQueueing) {
+    auto snapshot = std::make_shared<utility::ConfigSnapshot>(
+            utility::ConfigSnapshot::fromData({{"RMin", 10}, {"RMax", 20}, {"NumberFilter.7495", 0}}, "base.json"));
+    EXPECT_CALL(*mockConfig, getSnapshot()).WillOnce(::testing::Return(snapshot));
+    auto filtered = std::make_shared<Manager>(mockConfig, mockThreadPool);
+
+    EXPECT_CALL(*mockThreadPool, add_task(::testing::_, ::testing::_)).WillOnce(::testing::Return(10));
+    EXPECT_CALL(*mockThreadPool, reject(::testing::_, CallStatus::Rejected))
+            .WillOnce([](std::shared_ptr<TP::ITask> task, CallStatus status) {
+                task->complete(Result{status, std::chrono::seconds{0}, 11});
+                return 11;
+            });
+    std::optional<CallStatus> status;
+    EXPECT_EQ(filtered->addTask("74951234567", [&status](std::exception_ptr, Result result) { status = result.status; }), 11);
+    EXPECT_EQ(status, CallStatus::Rejected);
+    EXPECT_EQ(filtered->addTask("78121234567", [](std::exception_ptr, Result) { }), 10);
+}
+
+TEST(ThreadPoolRejectTest, RejectWritesCdrAndCompletesTask) {
+    auto pool = std::make_shared<TP::ThreadPool>(1, 4);
+    auto queue = std::make_shared<MockQueue>(4);
+    pool->setTaskQueue(queue);
+    CDR written;
+    EXPECT_CALL(*queue, writeCDR(::testing::_)).WillOnce([&written](const CDR& cdr) { written = cdr; });
+    EXPECT_CALL(*queue, push(::testing::_)).Times(0);
+
+    auto promise = std::make_shared<std::promise<Result>>();
+    auto result = promise->get_future();
+    auto rejected = std::make_shared<TP::Task>(10, 20, "74951234567", std::chrono::system_clock::now(), nullptr, promise);
+    auto callID = pool->reject(rejected, CallStatus::Rejected);
+    EXPECT_EQ(result.get().status, CallStatus::Rejected);
+    EXPECT_EQ(written.callID, callID);
+    EXPECT_EQ(written.status, CallStatus::Rejected);
+}
+
 TEST_F(ManagerTest, UpdateFunctionWhenThreadPoolSizeAreSame) {
-    EXPECT_CALL(*mockConfig, getMinMax()).WillOnce(::testing::Return(std::make_pair(10,20)));
-    EXPECT_CALL(*mockConfig, getAmountOfOperators()).WillOnce(::testing::Return(2));
-    EXPECT_CALL(*mockConfig, getSizeOfQueue()).Times(1).WillRepeatedly(::testing::Return(4));
+    EXPECT_CALL(*mockConfig, getSnapshot()).WillOnce(::testing::Return(makeSnapshot(2)));
     EXPECT_CALL(*mockQueue, empty()).Times(::testing::AnyNumber()).WillRepeatedly(::testing::Return(true));
     EXPECT_CALL(*mockQueue, update(::testing::_)).Times(1);
 
@@ -119,9 +199,7 @@ TEST_F(ManagerTest, UpdateFunctionWhenThreadPoolSizeAreSame) {
 }
 
 TEST_F(ManagerTest, UpdateFunctionWhenThreadPoolSizeAreNotSame) {
-    EXPECT_CALL(*mockConfig, getMinMax()).WillOnce(::testing::Return(std::make_pair(10,20)));
-    EXPECT_CALL(*mockConfig, getAmountOfOperators()).Times(2).WillRepeatedly(::testing::Return(3));
-    EXPECT_CALL(*mockConfig, getSizeOfQueue()).Times(2).WillRepeatedly(::testing::Return(4));
+    EXPECT_CALL(*mockConfig, getSnapshot()).WillOnce(::testing::Return(makeSnapshot(3)));
     EXPECT_CALL(*mockQueue, empty()).Times(::testing::AnyNumber()).WillRepeatedly(::testing::Return(true));
     EXPECT_CALL(*mockQueue, update(::testing::_)).Times(1);
 
@@ -129,6 +207,8 @@ TEST_F(ManagerTest, UpdateFunctionWhenThreadPoolSizeAreNotSame) {
     manager->setNewThreadPool(threadPool);
     threadPool->setTaskQueue(mockQueue);
     manager->update();
+    // Пул изменяет количество операторов на месте, без замены объекта пула.
+    EXPECT_EQ(threadPool->getSize(), 3);
 }
 
 TEST_F(ManagerTest, updateViaRequest) {
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+#include "prefixTrie.hpp"
+
+TEST(PrefixTrieTest, LongestPrefixWins) {
+    utility::PrefixTrie trie;
+    trie.insert("8", 0);
+    trie.insert("8800", 1);
+    trie.insert("88005", 2);
+    EXPECT_EQ(trie.size(), 3);
+
+    EXPECT_EQ(trie.match("89001234567"), 0);
+    EXPECT_EQ(trie.match("88001234567"), 1);
+    EXPECT_EQ(trie.match("88005553535"), 2);
+    EXPECT_EQ(trie.match("880"), 0);
+    EXPECT_EQ(trie.match("79001234567"), utility::PrefixTrie::none);
+}
+
+TEST(PrefixTrieTest, EmptyPrefixMatchesEverything) {
+    utility::PrefixTrie trie;
+    EXPECT_TRUE(trie.empty());
+    EXPECT_EQ(trie.match("112"), utility::PrefixTrie::none);
+    trie.insert("", 1);
+    trie.insert("112", 2);
+    EXPECT_EQ(trie.match("79001234567"), 1);
+    EXPECT_EQ(trie.match("112"), 2);
+    EXPECT_EQ(trie.match(""), 1);
+}
+
+TEST(PrefixTrieTest, InsertReplacesValueAndStopsAtNonDigit) {
+    utility::PrefixTrie trie;
+    trie.insert("112", 1);
+    trie.insert("112", 2);
+    EXPECT_EQ(trie.size(), 1);
+    EXPECT_EQ(trie.match("112"), 2);
+    EXPECT_EQ(trie.match("+112"), utility::PrefixTrie::none);
+    EXPECT_EQ(trie.match("11+2"), utility::PrefixTrie::none);
+    EXPECT_THROW(trie.insert("11a", 1), std::invalid_argument);
+    EXPECT_THROW(trie.insert("11", -1), std::invalid_argument);
+}
+
+TEST(PrefixTrieTest, CompactKeepsMatchesAndFreezesTrie) {
+    utility::PrefixTrie trie;
+    trie.insert("", 1);
+    trie.insert("7495", 0);
+    trie.insert("7495123", 1);
+    trie.insert("7812", 0);
+    trie.insert("8", 0);
+    const char* numbers[] = {"74951234567", "74959876543", "78121234567", "78131234567", "89001234567", "", "7495+1"};
+    std::vector<int> before;
+    for (auto number: numbers)
+        before.push_back(trie.match(number));
+
+    trie.compact();
+    for (std::size_t i = 0; i < std::size(numbers); ++i)
+        EXPECT_EQ(trie.match(numbers[i]), before[i]) << numbers[i];
+    EXPECT_EQ(trie.size(), 5);
+    EXPECT_THROW(trie.insert("9", 0), std::logic_error);
+}
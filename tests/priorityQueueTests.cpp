@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "priorityQueue.hpp"
+#include "task.hpp"
+
+namespace {
+std::shared_ptr<const utility::PrefixTrie> makeRules() {
+    auto rules = std::make_shared<utility::PrefixTrie>();
+    rules->insert("112", static_cast<int>(PriorityClass::Emergency));
+    rules->insert("8800", static_cast<int>(PriorityClass::Vip));
+    return rules;
+}
+
+std::shared_ptr<TP::Task> makeTask(const std::string& number) {
+    return std::make_shared<TP::Task>(1, 60, number, std::chrono::system_clock::now(), nullptr);
+}
+}
+
+TEST(PriorityQueueTest, ClassifiesByPrefix) {
+    TP::PriorityQueue queue(8, makeRules(), {1, 1, 1});
+    EXPECT_EQ(queue.classify(utility::CallerNumber{"112"}), PriorityClass::Emergency);
+    EXPECT_EQ(queue.classify(utility::CallerNumber{"88001234567"}), PriorityClass::Vip);
+    EXPECT_EQ(queue.classify(utility::CallerNumber{"89001234567"}), PriorityClass::Normal);
+
+    TP::PriorityQueue withoutRules(8, nullptr, {1, 1, 1});
+    EXPECT_EQ(withoutRules.classify(utility::CallerNumber{"112"}), PriorityClass::Normal);
+}
+
+TEST(PriorityQueueTest, WeightedRoundRobinAcrossClasses) {
+    TP::PriorityQueue queue(16, makeRules(), {1, 2, 3});
+    std::vector<std::string> numbers;
+    for (int i = 0; i < 4; ++i) {
+        numbers.push_back("8900" + std::to_string(i));
+        numbers.push_back("8800" + std::to_string(i));
+        numbers.push_back("112" + std::to_string(i));
+    }
+    TP::CallID callID = 0;
+    for (const auto& number: numbers)
+        EXPECT_TRUE(queue.push(std::make_pair(makeTask(number), ++callID)));
+    EXPECT_EQ(queue.depth(PriorityClass::Normal), 4);
+    EXPECT_EQ(queue.depth(PriorityClass::Vip), 4);
+    EXPECT_EQ(queue.depth(PriorityClass::Emergency), 4);
+
+    std::string order;
+    std::pair<std::shared_ptr<TP::ITask>, TP::CallID> taken;
+    while (queue.tryPop(taken))
+        order += std::to_string(static_cast<int>(taken.first->cdr.priority));
+    // За проход экстренные отдают 3 вызова, VIP – 2, обычные – 1, опустевший класс пропускается.
+    EXPECT_EQ(order, "222110211000");
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.depth(PriorityClass::Normal), 0);
+}
+
+TEST(PriorityQueueTest, EmergencyJumpsAheadOfWaitingCalls) {
+    TP::PriorityQueue queue(16, makeRules(), {1, 4, 16});
+    EXPECT_TRUE(queue.push(std::make_pair(makeTask("89001"), 1)));
+    EXPECT_TRUE(queue.push(std::make_pair(makeTask("89002"), 2)));
+    EXPECT_TRUE(queue.push(std::make_pair(makeTask("112"), 3)));
+
+    std::pair<std::shared_ptr<TP::ITask>, TP::CallID> taken;
+    EXPECT_TRUE(queue.tryPop(taken));
+    EXPECT_EQ(taken.second, 3);
+    EXPECT_TRUE(queue.tryPop(taken));
+    EXPECT_EQ(taken.second, 1);
+}
+
+TEST(PriorityQueueTest, SizeLimitsAllClassesAndDuplicatesStayInClass) {
+    TP::PriorityQueue queue(2, makeRules(), {1, 4, 16});
+    auto first = makeTask("112");
+    EXPECT_TRUE(queue.push(std::make_pair(first, 1)));
+    EXPECT_TRUE(queue.push(std::make_pair(makeTask("89001"), 2)));
+    auto rejected = makeTask("88001");
+    EXPECT_FALSE(queue.push(std::make_pair(rejected, 3)));
+    EXPECT_EQ(rejected->promise_->get_future().get().status, CallStatus::Overloaded);
+
+    std::pair<std::shared_ptr<TP::ITask>, TP::CallID> taken;
+    EXPECT_TRUE(queue.tryPop(taken));
+    EXPECT_TRUE(queue.push(std::make_pair(makeTask("112"), 4)));
+    EXPECT_TRUE(queue.tryPop(taken));
+    EXPECT_EQ(taken.second, 4);
+    EXPECT_EQ(queue.depth(PriorityClass::Emergency), 0);
+    EXPECT_EQ(queue.depth(PriorityClass::Normal), 1);
+}
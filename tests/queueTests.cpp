@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <optional>
 #include "threadpool.hpp"
 #include "queue.hpp"
 #include "task.hpp"
@@ -76,3 +77,220 @@ TEST(QueueTest, Duplication) {
     auto fut = task1->promise_->get_future().get();
     EXPECT_EQ(fut.status, CallStatus::Duplication);
 }
+
+TEST(QueueTest, DuplicationCallsCompletionHandler) {
+    TP::Queue queue(3);
+    std::chrono::system_clock::time_point time;
+    std::shared_ptr<spdlog::logger> logger = nullptr;
+    auto task1 = std::make_shared<TP::Task>(1,2,"1", time, logger);
+    auto task2 = std::make_shared<TP::Task>(1,2,"1", time, logger);
+    std::optional<Result> result;
+    task1->addCompletionHandler([&result](std::exception_ptr exception, Result r) {
+        EXPECT_FALSE(exception);
+        result = r;
+    });
+
+    EXPECT_TRUE(queue.push(std::make_pair(task1, 1)));
+    EXPECT_TRUE(queue.push(std::make_pair(task2, 2)));
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->status, CallStatus::Duplication);
+    EXPECT_EQ(result->callID, 1);
+}
+
+TEST(QueueTest, DuplicationOutlivesRequestBuffers) {
+    TP::Queue queue(3);
+    std::chrono::system_clock::time_point time;
+    std::shared_ptr<spdlog::logger> logger = nullptr;
+    auto request = std::make_unique<std::string>("89001234567");
+    auto task1 = std::make_shared<TP::Task>(1, 2, *request, time, logger);
+    EXPECT_TRUE(queue.push(std::make_pair(task1, 1)));
+    request.reset();
+
+    std::string again = "89001234567";
+    EXPECT_TRUE(queue.push(std::make_pair(std::make_shared<TP::Task>(1, 2, again, time, logger), 2)));
+    EXPECT_EQ(task1->promise_->get_future().get().status, CallStatus::Duplication);
+    EXPECT_EQ(task1->cdr.number.view(), "89001234567");
+}
+
+TEST(QueueTest, DuplicationMovesCallToBack) {
+    TP::Queue queue(3);
+    std::chrono::system_clock::time_point time;
+    std::shared_ptr<spdlog::logger> logger = nullptr;
+    auto task1 = std::make_shared<TP::Task>(1, 2, "1", time, logger);
+    auto task2 = std::make_shared<TP::Task>(1, 2, "2", time, logger);
+    auto task3 = std::make_shared<TP::Task>(1, 2, "1", time, logger);
+
+    EXPECT_TRUE(queue.push(std::make_pair(task1, 1)));
+    EXPECT_TRUE(queue.push(std::make_pair(task2, 2)));
+    EXPECT_TRUE(queue.push(std::make_pair(task3, 3)));
+
+    EXPECT_EQ(queue.front().first, task2);
+    EXPECT_EQ(queue.back().first, task3);
+    queue.pop();
+    EXPECT_EQ(queue.front().first, task3);
+    queue.pop();
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(QueueTest, WrapAroundKeepsOrder) {
+    TP::Queue queue(3);
+    std::chrono::system_clock::time_point time;
+    std::shared_ptr<spdlog::logger> logger = nullptr;
+    std::vector<std::string> numbers;
+    for (int i = 0; i < 100; ++i)
+        numbers.push_back(std::to_string(i));
+
+    for (int i = 0; i < 100; i += 2) {
+        auto first = std::make_shared<TP::Task>(1, 2, numbers[i], time, logger);
+        auto second = std::make_shared<TP::Task>(1, 2, numbers[i + 1], time, logger);
+        EXPECT_TRUE(queue.push(std::make_pair(first, i)));
+        EXPECT_TRUE(queue.push(std::make_pair(second, i + 1)));
+        EXPECT_EQ(queue.front().second, static_cast<TP::CallID>(i));
+        auto taken = std::move(queue.front());
+        queue.pop();
+        EXPECT_EQ(queue.front().second, static_cast<TP::CallID>(i + 1));
+        queue.pop();
+        EXPECT_TRUE(queue.empty());
+    }
+}
+
+TEST(QueueTest, RepeatedDuplicatesDoNotOverloadQueue) {
+    TP::Queue queue(3);
+    std::chrono::system_clock::time_point time;
+    std::shared_ptr<spdlog::logger> logger = nullptr;
+    auto other = std::make_shared<TP::Task>(1, 2, "2", time, logger);
+    EXPECT_TRUE(queue.push(std::make_pair(other, 0)));
+
+    std::shared_ptr<TP::Task> last;
+    for (int i = 1; i < 50; ++i) {
+        last = std::make_shared<TP::Task>(1, 2, "1", time, logger);
+        EXPECT_TRUE(queue.push(std::make_pair(last, i)));
+    }
+    EXPECT_EQ(queue.front().first, other);
+    EXPECT_EQ(queue.back().first, last);
+    queue.pop();
+    EXPECT_EQ(queue.front().first, last);
+    queue.pop();
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(QueueTest, UpdateIncreasesCapacity) {
+    TP::Queue queue(1);
+    std::chrono::system_clock::time_point time;
+    std::shared_ptr<spdlog::logger> logger = nullptr;
+    std::vector<std::string> numbers;
+    for (int i = 0; i < 10; ++i)
+        numbers.push_back(std::to_string(i));
+
+    EXPECT_TRUE(queue.push(std::make_pair(std::make_shared<TP::Task>(1, 2, numbers[0], time, logger), 0)));
+    queue.update(10);
+    for (int i = 1; i < 10; ++i)
+        EXPECT_TRUE(queue.push(std::make_pair(std::make_shared<TP::Task>(1, 2, numbers[i], time, logger), i)));
+    EXPECT_FALSE(queue.push(std::make_pair(std::make_shared<TP::Task>(1, 2, "10", time, logger), 10)));
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(queue.front().second, static_cast<TP::CallID>(i));
+        queue.pop();
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(QueueTest, CodelKeepsOrderWithoutDelay) {
+    TP::Queue queue(3);
+    queue.setCodel(std::chrono::milliseconds{10}, std::chrono::milliseconds{50});
+    auto time = std::chrono::system_clock::now();
+    std::shared_ptr<spdlog::logger> logger = nullptr;
+    auto task1 = std::make_shared<TP::Task>(1, 2, "1", time, logger);
+    auto task2 = std::make_shared<TP::Task>(1, 2, "2", time, logger);
+    EXPECT_TRUE(queue.push(std::make_pair(task1, 1)));
+    EXPECT_TRUE(queue.push(std::make_pair(task2, 2)));
+
+    std::pair<std::shared_ptr<TP::ITask>, TP::CallID> taken;
+    EXPECT_TRUE(queue.tryPop(taken));
+    EXPECT_EQ(taken.first, task1);
+    EXPECT_TRUE(queue.tryPop(taken));
+    EXPECT_EQ(taken.first, task2);
+    EXPECT_FALSE(queue.tryPop(taken));
+}
+
+TEST(QueueTest, CodelShedsHeadWhenDelayStaysAboveTarget) {
+    TP::Queue queue(4);
+    queue.setCodel(std::chrono::milliseconds{10}, std::chrono::milliseconds{50});
+    auto time = std::chrono::system_clock::now();
+    std::shared_ptr<spdlog::logger> logger = nullptr;
+    std::vector<std::shared_ptr<TP::Task>> tasks;
+    for (int i = 0; i < 4; ++i) {
+        tasks.push_back(std::make_shared<TP::Task>(1, 2, std::to_string(i), time, logger));
+        EXPECT_TRUE(queue.push(std::make_pair(tasks.back(), i)));
+    }
+
+    std::pair<std::shared_ptr<TP::ITask>, TP::CallID> taken;
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    // Первое превышение только запускает интервал наблюдения.
+    EXPECT_TRUE(queue.tryPop(taken));
+    EXPECT_EQ(taken.first, tasks[0]);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{60});
+    EXPECT_TRUE(queue.tryPop(taken));
+    EXPECT_EQ(taken.first, tasks[2]);
+    auto shed = tasks[1]->promise_->get_future().get();
+    EXPECT_EQ(shed.status, CallStatus::Overloaded);
+    EXPECT_EQ(shed.callID, 1);
+}
+
+TEST(QueueTest, ExpireCompletesCallsPastDeadline) {
+    TP::Queue queue(3);
+    auto time = std::chrono::system_clock::now();
+    std::shared_ptr<spdlog::logger> logger = nullptr;
+    auto task1 = std::make_shared<TP::Task>(1, 5, "1", time, logger);
+    auto task2 = std::make_shared<TP::Task>(1, 1, "2", time, logger);
+    auto task3 = std::make_shared<TP::Task>(1, 3, "3", time, logger);
+    EXPECT_TRUE(queue.push(std::make_pair(task1, 1)));
+    EXPECT_TRUE(queue.push(std::make_pair(task2, 2)));
+    EXPECT_TRUE(queue.push(std::make_pair(task3, 3)));
+    EXPECT_EQ(queue.nextDeadline(), time + std::chrono::seconds{1});
+
+    EXPECT_EQ(queue.expire(time), 0);
+    EXPECT_EQ(queue.expire(time + std::chrono::seconds{3}), 2);
+    auto expired = task3->promise_->get_future().get();
+    EXPECT_EQ(expired.status, CallStatus::Timeout);
+    EXPECT_EQ(expired.callID, 3);
+    EXPECT_EQ(task2->promise_->get_future().get().status, CallStatus::Timeout);
+    EXPECT_EQ(queue.nextDeadline(), time + std::chrono::seconds{5});
+    EXPECT_EQ(queue.front().first, task1);
+    EXPECT_EQ(queue.back().first, task1);
+}
+
+TEST(QueueTest, TryPopSkipsExpiredCalls) {
+    TP::Queue queue(3);
+    auto now = std::chrono::system_clock::now();
+    std::shared_ptr<spdlog::logger> logger = nullptr;
+    auto dead = std::make_shared<TP::Task>(1, 2, "1", now - std::chrono::seconds{5}, logger);
+    auto alive = std::make_shared<TP::Task>(1, 2, "2", now, logger);
+    EXPECT_TRUE(queue.push(std::make_pair(dead, 1)));
+    EXPECT_TRUE(queue.push(std::make_pair(alive, 2)));
+
+    std::pair<std::shared_ptr<TP::ITask>, TP::CallID> taken;
+    EXPECT_TRUE(queue.tryPop(taken));
+    EXPECT_EQ(taken.first, alive);
+    EXPECT_EQ(dead->promise_->get_future().get().status, CallStatus::Timeout);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.nextDeadline(), std::chrono::system_clock::time_point::max());
+}
+
+TEST(QueueTest, DeadlinesFollowDuplicatesAndRebuild) {
+    TP::Queue queue(3);
+    auto time = std::chrono::system_clock::now();
+    std::shared_ptr<spdlog::logger> logger = nullptr;
+    EXPECT_TRUE(queue.push(std::make_pair(std::make_shared<TP::Task>(1, 1, "1", time, logger), 1)));
+    EXPECT_TRUE(queue.push(std::make_pair(std::make_shared<TP::Task>(1, 4, "2", time, logger), 2)));
+    // Повторный вызов заменяет первый, его срок удаляется из кучи.
+    EXPECT_TRUE(queue.push(std::make_pair(std::make_shared<TP::Task>(1, 2, "1", time, logger), 3)));
+    EXPECT_EQ(queue.nextDeadline(), time + std::chrono::seconds{2});
+
+    queue.update(8);
+    for (int i = 0; i < 6; ++i)
+        EXPECT_TRUE(queue.push(std::make_pair(std::make_shared<TP::Task>(1, 10 - i, std::to_string(10 + i), time, logger), 4 + i)));
+    EXPECT_EQ(queue.expire(time + std::chrono::seconds{4}), 2);
+    EXPECT_EQ(queue.nextDeadline(), time + std::chrono::seconds{5});
+    EXPECT_EQ(queue.front().second, 4);
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include "recorder.hpp"
+
+namespace {
+std::size_t countRecords(const std::filesystem::path& path, const std::string& number) {
+    std::ifstream in(path);
+    std::size_t count = 0;
+    for (std::string line; std::getline(in, line);)
+        if (line.find(";" + number + ";") != std::string::npos)
+            ++count;
+    return count;
+}
+
+CDR makeCDR(std::string_view number, TP::CallID callID) {
+    CDR cdr{};
+    cdr.startTime = std::chrono::system_clock::now();
+    cdr.callID = callID;
+    cdr.status = CallStatus::Completed;
+    cdr.callDuration = std::chrono::seconds{1};
+    cdr.number = number;
+    return cdr;
+}
+}
+
+TEST(AsyncFileRecorderTest, FlushWritesAllRecords) {
+    std::filesystem::path path = "asyncRecorderFlush.txt";
+    std::filesystem::remove(path);
+    AsyncFileRecorder recorder(path, CdrDurability::Flush, 1 << 20, std::chrono::milliseconds{10000});
+    for (TP::CallID i = 0; i < 100; ++i)
+        recorder.makeRecord(makeCDR("89001112233", i));
+    recorder.flush();
+    EXPECT_EQ(countRecords(path, "89001112233"), 100);
+}
+
+TEST(AsyncFileRecorderTest, WritesRecordsOnDestruction) {
+    std::filesystem::path path = "asyncRecorderShutdown.txt";
+    std::filesystem::remove(path);
+    {
+        AsyncFileRecorder recorder(path, CdrDurability::None);
+        for (TP::CallID i = 0; i < 10; ++i) {
+            // Номер живет меньше записи, писатель должен хранить его копию.
+            std::string number = "7900";
+            recorder.makeRecord(makeCDR(number, i));
+        }
+    }
+    EXPECT_EQ(countRecords(path, "7900"), 10);
+}
+
+TEST(AsyncFileRecorderTest, FlushesByInterval) {
+    std::filesystem::path path = "asyncRecorderInterval.txt";
+    std::filesystem::remove(path);
+    AsyncFileRecorder recorder(path, CdrDurability::Fdatasync, 1 << 20, std::chrono::milliseconds{20});
+    recorder.makeRecord(makeCDR("123", 1));
+    std::this_thread::sleep_for(std::chrono::milliseconds{500});
+    EXPECT_EQ(countRecords(path, "123"), 1);
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <optional>
+#include "threadpool.hpp"
+#include "shardedQueue.hpp"
+#include "task.hpp"
+
+TEST(ShardedQueueTest, TwoShardsKeepGlobalOrder) {
+    TP::ShardedQueue queue(16, 2);
+    std::chrono::system_clock::time_point time;
+    std::shared_ptr<spdlog::logger> logger = nullptr;
+    std::vector<std::string> numbers;
+    for (int i = 0; i < 8; ++i)
+        numbers.push_back(std::to_string(i));
+    std::vector<std::shared_ptr<TP::Task>> tasks;
+    for (TP::CallID i = 0; i < numbers.size(); ++i) {
+        tasks.push_back(std::make_shared<TP::Task>(1, 2, numbers[i], time, logger));
+        EXPECT_TRUE(queue.push(std::make_pair(tasks.back(), i)));
+    }
+
+    // С двумя очередями оператор всегда сравнивает свою очередь с единственной соседней.
+    std::pair<std::shared_ptr<TP::ITask>, TP::CallID> taskPair;
+    for (TP::CallID i = 0; i < numbers.size(); ++i) {
+        ASSERT_TRUE(queue.tryPop(taskPair, i % 2));
+        EXPECT_EQ(taskPair.second, i);
+    }
+    EXPECT_FALSE(queue.tryPop(taskPair, 0));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(ShardedQueueTest, IdleOperatorStealsFromPeers) {
+    TP::ShardedQueue queue(16, 4);
+    std::chrono::system_clock::time_point time;
+    std::shared_ptr<spdlog::logger> logger = nullptr;
+    std::vector<std::string> numbers{"100", "200", "300", "400", "500", "600"};
+    for (TP::CallID i = 0; i < numbers.size(); ++i)
+        EXPECT_TRUE(queue.push(std::make_pair(std::make_shared<TP::Task>(1, 2, numbers[i], time, logger), i)));
+
+    std::pair<std::shared_ptr<TP::ITask>, TP::CallID> taskPair;
+    std::vector<TP::CallID> popped;
+    while (queue.tryPop(taskPair, 3))
+        popped.push_back(taskPair.second);
+    std::sort(popped.begin(), popped.end());
+    EXPECT_EQ(popped, (std::vector<TP::CallID>{0, 1, 2, 3, 4, 5}));
+}
+
+TEST(ShardedQueueTest, DuplicationAndOverload) {
+    TP::ShardedQueue queue(2, 4);
+    std::chrono::system_clock::time_point time;
+    std::shared_ptr<spdlog::logger> logger = nullptr;
+    auto task1 = std::make_shared<TP::Task>(1, 2, "1", time, logger);
+    auto task2 = std::make_shared<TP::Task>(1, 2, "2", time, logger);
+    auto task3 = std::make_shared<TP::Task>(1, 2, "1", time, logger);
+    auto task4 = std::make_shared<TP::Task>(1, 2, "4", time, logger);
+    std::optional<Result> result;
+    task1->addCompletionHandler([&result](std::exception_ptr, Result r) { result = r; });
+    TP::CallID id = 1;
+    task1->setCallID(id);
+
+    EXPECT_TRUE(queue.push(std::make_pair(task1, 1)));
+    EXPECT_TRUE(queue.push(std::make_pair(task3, 2)));
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->status, CallStatus::Duplication);
+    EXPECT_TRUE(queue.push(std::make_pair(task2, 3)));
+    EXPECT_FALSE(queue.push(std::make_pair(task4, 4)));
+    EXPECT_EQ(task4->promise_->get_future().get().status, CallStatus::Overloaded);
+
+    std::pair<std::shared_ptr<TP::ITask>, TP::CallID> taskPair;
+    std::vector<TP::CallID> popped;
+    while (queue.tryPop(taskPair, 0))
+        popped.push_back(taskPair.second);
+    std::sort(popped.begin(), popped.end());
+    EXPECT_EQ(popped, (std::vector<TP::CallID>{2, 3}));
+}
+
+TEST(ShardedQueueTest, ThreadPoolProcessesTasks) {
+    auto time = std::chrono::system_clock::now();
+    std::shared_ptr<spdlog::logger> logger = nullptr;
+    auto pool = std::make_shared<TP::ThreadPool>(4, 64);
+    pool->setTaskQueue(std::make_shared<TP::ShardedQueue>(64, pool->getWorkerCount()));
+    pool->start();
+
+    std::vector<std::string> numbers;
+    for (int i = 1; i <= 8; ++i)
+        numbers.push_back(std::to_string(i));
+    std::vector<std::future<Result>> futures;
+    for (const auto& number: numbers)
+        futures.push_back(pool->add_task(std::make_shared<TP::Task>(1, 1, number, time, logger)).second);
+    for (auto& future: futures)
+        EXPECT_EQ(future.get().status, CallStatus::Completed);
+}
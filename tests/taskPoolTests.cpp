@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include "taskPool.hpp"
+#include "task.hpp"
+#include "threadpool.hpp"
+
+namespace {
+std::atomic<bool> countAllocations{false};
+std::atomic<std::size_t> allocations{0};
+}
+
+// Счетчик выделений памяти для всего тестового бинарника, считает только между включением и выключением.
+void* operator new(std::size_t size) {
+    if (countAllocations.load(std::memory_order_relaxed))
+        allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto* pointer = std::malloc(size ? size : 1))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+namespace {
+constexpr std::size_t calls = 20000;
+
+std::vector<std::string> makeNumbers() {
+    std::vector<std::string> numbers(calls);
+    for (std::size_t i = 0; i < calls; ++i)
+        numbers[i] = std::to_string(89000000000ull + i);
+    return numbers;
+}
+
+std::size_t countRound(TP::TaskPool* tasks, TP::ThreadPool& pool, const std::vector<std::string>& numbers,
+                       std::vector<std::future<Result>>& futures) {
+    std::atomic<std::size_t> completed{0};
+    futures.clear();
+    auto now = std::chrono::system_clock::now();
+    allocations = 0;
+    countAllocations = true;
+    for (std::size_t i = 0; i < calls; ++i) {
+        // Без пула задача создается, как до его появления: make_shared и промис в конструкторе Task.
+        std::shared_ptr<TP::ITask> task = tasks ? tasks->makeTask(0, 0, numbers[i], now, nullptr)
+                                                : std::make_shared<TP::Task>(0, 0, numbers[i], now, nullptr);
+        if (i % 2) {
+            pool.add_task(std::move(task), [&completed](std::exception_ptr, Result) { ++completed; });
+        } else {
+            if (tasks)
+                task->addPromise(tasks->makePromise());
+            futures.push_back(pool.add_task(std::move(task)).second);
+        }
+    }
+    for (auto& future: futures)
+        future.wait();
+    while (completed < calls / 2)
+        std::this_thread::yield();
+    countAllocations = false;
+    return allocations;
+}
+}
+
+TEST(TaskPoolTest, CompletesThroughHandlerOrPromise) {
+    TP::TaskPool tasks;
+    std::chrono::system_clock::time_point time;
+    auto withHandler = tasks.makeTask(0, 1, "1", time, nullptr);
+    EXPECT_EQ(withHandler->promise_, nullptr);
+    Result received{};
+    withHandler->addCompletionHandler([&received](std::exception_ptr, Result result) { received = result; });
+    Result result{};
+    result.status = CallStatus::Duplication;
+    withHandler->complete(result);
+    EXPECT_EQ(received.status, CallStatus::Duplication);
+
+    auto withPromise = tasks.makeTask(0, 1, "2", time, nullptr);
+    withPromise->addPromise(tasks.makePromise());
+    auto future = withPromise->promise_->get_future();
+    withPromise->complete(result);
+    EXPECT_EQ(future.get().status, CallStatus::Duplication);
+}
+
+TEST(TaskPoolTest, ReusesBlocksAfterTasksAreReleased) {
+    TP::TaskPool tasks;
+    std::chrono::system_clock::time_point time;
+    for (int round = 0; round < 4; ++round) {
+        std::vector<std::shared_ptr<TP::ITask>> alive;
+        for (std::size_t i = 0; i < TP::TaskPool::blocksPerSlab; ++i)
+            alive.push_back(tasks.makeTask(0, 1, "1", time, nullptr));
+        EXPECT_EQ(tasks.capacity(), TP::TaskPool::blocksPerSlab);
+    }
+}
+
+TEST(TaskPoolTest, CallsDoNotAllocateAfterWarmUp) {
+    auto numbers = makeNumbers();
+    std::vector<std::future<Result>> futures;
+    futures.reserve(calls);
+    TP::TaskPool tasks;
+    TP::ThreadPool pool(4, calls);
+    pool.start();
+
+    auto unpooled = countRound(nullptr, pool, numbers, futures);
+    // Первый проход наполняет пул, второй должен обходиться без кучи.
+    countRound(&tasks, pool, numbers, futures);
+    auto steady = countRound(&tasks, pool, numbers, futures);
+
+    EXPECT_GE(unpooled, 2 * calls);
+    EXPECT_LE(steady, calls / 100) << "allocations per call: " << static_cast<double>(steady) / calls;
+}
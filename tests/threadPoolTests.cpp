@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "threadpool.hpp"
+#include "task.hpp"
+#include "spdlog/sinks/null_sink.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+std::vector<std::future<Result>> addTasks(TP::ThreadPool& pool, const std::vector<std::string>& numbers) {
+    auto time = std::chrono::system_clock::now();
+    // Без логгера задача не выдерживает длительность разговора.
+    static auto logger = std::make_shared<spdlog::logger>("threadPoolTests", std::make_shared<spdlog::sinks::null_sink_mt>());
+    std::vector<std::future<Result>> futures;
+    for (const auto& number: numbers)
+        futures.push_back(pool.add_task(std::make_shared<TP::Task>(1, 1, number, time, logger)).second);
+    return futures;
+}
+}
+
+TEST(ThreadPoolTest, ResizeGrowsAndShrinksInPlace) {
+    TP::ThreadPool pool(2, 16);
+    pool.start();
+
+    pool.resize(4);
+    EXPECT_EQ(pool.getSize(), 4);
+    std::vector<std::string> grown{"1", "2", "3", "4"};
+    auto begin = std::chrono::steady_clock::now();
+    for (auto& future: addTasks(pool, grown))
+        EXPECT_EQ(future.get().status, CallStatus::Completed);
+    // Четыре оператора обслуживают четыре секундных разговора одновременно.
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, 2s);
+
+    pool.resize(1);
+    EXPECT_EQ(pool.getSize(), 1);
+    std::vector<std::string> shrunk{"5", "6"};
+    auto futures = addTasks(pool, shrunk);
+    // Второй вызов ждет единственного оператора дольше RMax и завершается по таймауту.
+    EXPECT_EQ(futures[0].get().status, CallStatus::Completed);
+    EXPECT_EQ(futures[1].get().status, CallStatus::Timeout);
+}
+
+TEST(ThreadPoolTest, ShrinkLetsCurrentCallsFinish) {
+    TP::ThreadPool pool(3, 16);
+    pool.start();
+    std::vector<std::string> numbers{"1", "2", "3"};
+    auto futures = addTasks(pool, numbers);
+    std::this_thread::sleep_for(100ms);
+
+    pool.resize(1);
+    pool.resize(2);
+    EXPECT_EQ(pool.getSize(), 2);
+    for (auto& future: futures)
+        EXPECT_EQ(future.get().status, CallStatus::Completed);
+}
+
+TEST(ThreadPoolTest, ResizeTimerWheelChangesOperatorLimit) {
+    TP::ThreadPool pool(2, 16, TP::OperatorMode::TimerWheel);
+    pool.start();
+    pool.resize(4);
+    EXPECT_EQ(pool.getSize(), 4);
+
+    std::vector<std::string> numbers{"1", "2", "3", "4"};
+    auto begin = std::chrono::steady_clock::now();
+    for (auto& future: addTasks(pool, numbers))
+        EXPECT_EQ(future.get().status, CallStatus::Completed);
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, 2s);
+}
+
+TEST(ThreadPoolTest, QueuedCallTimesOutAtDeadline) {
+    TP::ThreadPool pool(1, 16);
+    pool.start();
+    auto time = std::chrono::system_clock::now();
+    static auto logger = std::make_shared<spdlog::logger>("deadlineTests", std::make_shared<spdlog::sinks::null_sink_mt>());
+    auto busy = pool.add_task(std::make_shared<TP::Task>(3, 3, "1", time, logger)).second;
+    auto waiting = pool.add_task(std::make_shared<TP::Task>(1, 1, "2", time, logger)).second;
+
+    // Единственный оператор занят три секунды, ожидающий вызов завершается через секунду по сроку ожидания.
+    auto begin = std::chrono::steady_clock::now();
+    EXPECT_EQ(waiting.get().status, CallStatus::Timeout);
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, 2s);
+    EXPECT_EQ(busy.get().status, CallStatus::Completed);
+}
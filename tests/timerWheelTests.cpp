@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "threadpool.hpp"
+#include "timerWheel.hpp"
+#include "task.hpp"
+
+using namespace std::chrono_literals;
+
+TEST(TimerWheelTest, FiresAfterDelay) {
+    TP::TimerWheel::Clock::time_point start;
+    TP::TimerWheel wheel(10ms, start);
+    int fired = 0;
+    wheel.schedule(start, 50ms, [&fired]() { ++fired; });
+    EXPECT_EQ(wheel.size(), 1);
+    EXPECT_EQ(wheel.nextExpiry(), start + 50ms);
+
+    for (auto& callback: wheel.advance(start + 40ms))
+        callback();
+    EXPECT_EQ(fired, 0);
+    for (auto& callback: wheel.advance(start + 50ms))
+        callback();
+    EXPECT_EQ(fired, 1);
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTest, CascadesLongDelays) {
+    TP::TimerWheel::Clock::time_point start;
+    TP::TimerWheel wheel(10ms, start);
+    auto now = start;
+    std::vector<std::chrono::seconds> fired;
+    for (auto delay: {140s, 10s, 1s})
+        wheel.schedule(start, delay, [&fired, &now, start]() {
+            fired.push_back(std::chrono::duration_cast<std::chrono::seconds>(now - start));
+        });
+
+    while (!wheel.empty()) {
+        now = wheel.nextExpiry();
+        for (auto& callback: wheel.advance(now))
+            callback();
+    }
+    EXPECT_EQ(fired, (std::vector<std::chrono::seconds>{1s, 10s, 140s}));
+}
+
+TEST(TimerWheelTest, DoesNotFireEarlyAfterIdle) {
+    TP::TimerWheel::Clock::time_point start;
+    TP::TimerWheel wheel(10ms, start);
+    EXPECT_TRUE(wheel.advance(start + 1h).empty());
+
+    int fired = 0;
+    wheel.schedule(start + 2h, 5s, [&fired]() { ++fired; });
+    EXPECT_TRUE(wheel.advance(start + 2h + 4s).empty());
+    for (auto& callback: wheel.advance(start + 2h + 5s))
+        callback();
+    EXPECT_EQ(fired, 1);
+}
+
+TEST(TimerWheelTest, ThreadPoolLimitsConcurrentCalls) {
+    auto time = std::chrono::system_clock::now();
+    std::shared_ptr<spdlog::logger> logger = nullptr;
+    auto pool = std::make_shared<TP::ThreadPool>(2, 16, TP::OperatorMode::TimerWheel);
+    EXPECT_EQ(pool->getSize(), 2);
+    pool->start();
+
+    std::vector<std::string> numbers{"1", "2", "3", "4"};
+    std::vector<std::future<Result>> futures;
+    auto begin = std::chrono::steady_clock::now();
+    for (const auto& number: numbers)
+        futures.push_back(pool->add_task(std::make_shared<TP::Task>(1, 2, number, time, logger)).second);
+    for (auto& future: futures)
+        future.get();
+
+    // Два оператора, четыре разговора не короче секунды – не меньше двух секунд.
+    EXPECT_GE(std::chrono::steady_clock::now() - begin, 2s);
+}
+
+TEST(TimerWheelTest, ThreadPoolSimulatesManyOperators) {
+    auto time = std::chrono::system_clock::now();
+    std::shared_ptr<spdlog::logger> logger = nullptr;
+    constexpr int calls = 500;
+    auto pool = std::make_shared<TP::ThreadPool>(calls, calls, TP::OperatorMode::TimerWheel);
+    pool->start();
+
+    std::vector<std::string> numbers;
+    for (int i = 1; i <= calls; ++i)
+        numbers.push_back(std::to_string(i));
+    std::vector<std::future<Result>> futures;
+    auto begin = std::chrono::steady_clock::now();
+    for (const auto& number: numbers)
+        futures.push_back(pool->add_task(std::make_shared<TP::Task>(1, 2, number, time, logger)).second);
+    for (auto& future: futures)
+        EXPECT_EQ(future.get().status, CallStatus::Completed);
+
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, 10s);
+}
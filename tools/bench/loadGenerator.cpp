@@ -0,0 +1,380 @@
+#include "loadGenerator.hpp"
+#include "cdrFormatter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <stdexcept>
+
+/**
+ * @file loadGenerator.cpp
+ * @brief Содержит определение генератора нагрузки protei_cov_bench
+ */
+
+using namespace bench;
+
+namespace {
+/// Исход "ошибка соединения" следует за значениями CallStatus.
+constexpr std::size_t errorOutcome = Report::outcomeCount - 1;
+
+/// Первый номер звонящего, к нему прибавляется номер из распределения.
+constexpr std::uint64_t firstNumber = 89000000000ull;
+
+/**
+ * @brief Восстанавливает статус вызова по коду ответа HttpServer::workWithCallStatus.
+ */
+std::size_t outcomeOf(unsigned status) {
+    switch (status) {
+    case 200: return static_cast<std::size_t>(CallStatus::Completed);
+    case 409: return static_cast<std::size_t>(CallStatus::Duplication);
+    case 429: return static_cast<std::size_t>(CallStatus::Overloaded);
+    case 406: return static_cast<std::size_t>(CallStatus::Rejected);
+    case 408: return static_cast<std::size_t>(CallStatus::Timeout);
+    default: return errorOutcome;
+    }
+}
+
+std::string_view outcomeName(std::size_t outcome) {
+    return outcome == errorOutcome ? std::string_view{"Error"} : utility::statusName(static_cast<CallStatus>(outcome));
+}
+
+double toMilliseconds(std::chrono::microseconds value) {
+    return static_cast<double>(value.count()) / 1000.0;
+}
+
+std::uint64_t toNumber(std::string_view key, std::string_view value) {
+    try {
+        return std::stoull(std::string{value});
+    } catch (const std::exception&) {
+        throw std::invalid_argument("invalid value for --" + std::string{key} + ": " + std::string{value});
+    }
+}
+
+double toDouble(std::string_view key, std::string_view value) {
+    try {
+        return std::stod(std::string{value});
+    } catch (const std::exception&) {
+        throw std::invalid_argument("invalid value for --" + std::string{key} + ": " + std::string{value});
+    }
+}
+}
+
+Options Options::parse(int argc, const char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view argument{argv[i]};
+        auto separator = argument.find('=');
+        if (argument.substr(0, 2) != "--" || separator == std::string_view::npos)
+            throw std::invalid_argument("expected --key=value, got " + std::string{argument});
+        auto key = argument.substr(2, separator - 2);
+        auto value = argument.substr(separator + 1);
+        if (key == "host") {
+            options.host = value;
+        } else if (key == "port") {
+            options.port = value;
+        } else if (key == "mode") {
+            if (value != "open" && value != "closed")
+                throw std::invalid_argument("--mode must be open or closed");
+            options.mode = value == "open" ? Mode::Open : Mode::Closed;
+        } else if (key == "connections") {
+            options.connections = static_cast<unsigned>(std::max<std::uint64_t>(toNumber(key, value), 1));
+        } else if (key == "rate") {
+            options.rate = toDouble(key, value);
+            if (options.rate <= 0)
+                throw std::invalid_argument("--rate must be positive");
+        } else if (key == "duration") {
+            options.duration = std::chrono::seconds{toNumber(key, value)};
+        } else if (key == "drain") {
+            options.drain = std::chrono::seconds{toNumber(key, value)};
+        } else if (key == "requests") {
+            options.requests = toNumber(key, value);
+        } else if (key == "distribution") {
+            if (value == "sequential")
+                options.distribution = Distribution::Sequential;
+            else if (value == "uniform")
+                options.distribution = Distribution::Uniform;
+            else if (value == "zipf")
+                options.distribution = Distribution::Zipf;
+            else
+                throw std::invalid_argument("--distribution must be sequential, uniform or zipf");
+        } else if (key == "numbers") {
+            options.numbers = std::max<std::uint64_t>(toNumber(key, value), 1);
+        } else if (key == "zipf") {
+            options.zipfExponent = toDouble(key, value);
+        } else if (key == "seed") {
+            options.seed = toNumber(key, value);
+        } else {
+            throw std::invalid_argument("unknown argument --" + std::string{key});
+        }
+    }
+    return options;
+}
+
+std::string Options::usage() {
+    return "Usage: protei_cov_bench [--key=value ...]\n"
+           "  --host=127.0.0.1        server address\n"
+           "  --port=8080             server port\n"
+           "  --mode=closed|open      closed: next request after the response, open: constant arrival rate\n"
+           "  --connections=64        keep-alive connections\n"
+           "  --rate=100              requests per second in open mode\n"
+           "  --duration=10           seconds of load\n"
+           "  --drain=30              seconds to wait for outstanding responses\n"
+           "  --requests=0            request limit in closed mode, 0 - unlimited\n"
+           "  --distribution=sequential|uniform|zipf  caller numbers, uniform and zipf repeat numbers\n"
+           "  --numbers=1000          distinct caller numbers for uniform and zipf\n"
+           "  --zipf=1.0              zipf exponent\n"
+           "  --seed=1                random seed\n";
+}
+
+CallerNumbers::CallerNumbers(const Options& options) :
+    distribution_(options.distribution), rng_(options.seed), uniform_(0, options.numbers - 1) {
+    if (distribution_ == Distribution::Zipf) {
+        zipfCdf_.resize(options.numbers);
+        double sum = 0;
+        for (std::uint64_t rank = 0; rank < options.numbers; ++rank) {
+            sum += 1.0 / std::pow(static_cast<double>(rank + 1), options.zipfExponent);
+            zipfCdf_[rank] = sum;
+        }
+        for (auto& value: zipfCdf_)
+            value /= sum;
+    }
+}
+
+std::uint64_t CallerNumbers::next() {
+    switch (distribution_) {
+    case Distribution::Sequential:
+        return firstNumber + sequence_++;
+    case Distribution::Uniform:
+        return firstNumber + uniform_(rng_);
+    case Distribution::Zipf: {
+        auto point = std::uniform_real_distribution<double>(0.0, 1.0)(rng_);
+        auto it = std::lower_bound(zipfCdf_.begin(), zipfCdf_.end(), point);
+        auto rank = std::min<std::size_t>(static_cast<std::size_t>(it - zipfCdf_.begin()), zipfCdf_.size() - 1);
+        return firstNumber + rank;
+    }
+    }
+    return firstNumber;
+}
+
+Report::Report() {
+    for (auto& histogram: latency)
+        histogram = std::make_unique<utility::LatencyHistogram>();
+}
+
+void Report::print(std::ostream& out) const {
+    std::uint64_t responses = 0;
+    std::array<utility::LatencyHistogram::Snapshot, outcomeCount> snapshots;
+    for (std::size_t i = 0; i < outcomeCount; ++i) {
+        snapshots[i] = latency[i]->snapshot();
+        responses += snapshots[i].count;
+    }
+    auto seconds = std::chrono::duration<double>(elapsed).count();
+
+    out << "mode: " << (options.mode == Mode::Open ? "open" : "closed")
+        << ", connections: " << options.connections;
+    if (options.mode == Mode::Open)
+        out << ", rate: " << options.rate << "/s";
+    out << ", duration: " << options.duration.count() << " s\n";
+    out << "sent: " << sent << ", responses: " << responses << ", unfinished: " << unfinished << '\n';
+    out << "elapsed: " << std::fixed << std::setprecision(2) << seconds << " s, throughput: "
+        << (seconds > 0 ? static_cast<double>(responses) / seconds : 0.0) << " responses/s\n";
+    out << std::left << std::setw(12) << "status" << std::right << std::setw(10) << "count"
+        << std::setw(12) << "p50 ms" << std::setw(12) << "p99 ms" << std::setw(12) << "p999 ms" << '\n';
+    for (std::size_t i = 0; i < outcomeCount; ++i) {
+        if (snapshots[i].count == 0)
+            continue;
+        out << std::left << std::setw(12) << outcomeName(i) << std::right << std::setw(10) << snapshots[i].count
+            << std::setprecision(3)
+            << std::setw(12) << toMilliseconds(snapshots[i].percentile(50))
+            << std::setw(12) << toMilliseconds(snapshots[i].percentile(99))
+            << std::setw(12) << toMilliseconds(snapshots[i].percentile(99.9)) << '\n';
+    }
+}
+
+Connection::Connection(LoadGenerator& generator, asio::io_context& ioContext) :
+    generator_(generator), stream_(ioContext) {
+}
+
+void Connection::connect(const tcp::resolver::results_type& endpoints) {
+    endpoints_ = endpoints;
+    stream_.async_connect(endpoints_, [self = shared_from_this()](beast::error_code ec, const tcp::endpoint&) {
+        self->onConnect(ec);
+    });
+}
+
+void Connection::onConnect(beast::error_code ec) {
+    if (ec) {
+        // Соединение без запроса не переподключается, чтобы недоступный сервер не занял цикл.
+        if (busy_)
+            fail(ec);
+        else
+            std::cerr << "connect failed: " << ec.message() << '\n';
+        return;
+    }
+    stream_.socket().set_option(tcp::no_delay(true));
+    if (busy_)
+        beast::http::async_write(stream_, request_,
+                                 beast::bind_front_handler(&Connection::onWrite, shared_from_this()));
+    else
+        generator_.onIdle(shared_from_this());
+}
+
+void Connection::send(std::uint64_t number, Clock::time_point scheduled) {
+    busy_ = true;
+    scheduled_ = scheduled;
+    request_ = {};
+    request_.method(beast::http::verb::get);
+    request_.target("/phone=" + std::to_string(number));
+    request_.version(11);
+    request_.set(beast::http::field::host, generator_.options_.host);
+    request_.keep_alive(true);
+    beast::http::async_write(stream_, request_, beast::bind_front_handler(&Connection::onWrite, shared_from_this()));
+}
+
+void Connection::onWrite(beast::error_code ec, std::size_t) {
+    if (ec)
+        return fail(ec);
+    response_ = {};
+    beast::http::async_read(stream_, buffer_, response_,
+                            beast::bind_front_handler(&Connection::onRead, shared_from_this()));
+}
+
+void Connection::onRead(beast::error_code ec, std::size_t) {
+    if (ec)
+        return fail(ec);
+    busy_ = false;
+    generator_.onResponse(outcomeOf(response_.result_int()), Clock::now() - scheduled_);
+    if (!response_.keep_alive()) {
+        // Сервер закрывает соединение после MaxRequestsPerConnection запросов.
+        close();
+        return connect(endpoints_);
+    }
+    generator_.onIdle(shared_from_this());
+}
+
+void Connection::fail(beast::error_code ec) {
+    close();
+    if (!busy_)
+        return;
+    busy_ = false;
+    std::cerr << "request failed: " << ec.message() << '\n';
+    generator_.onResponse(errorOutcome, Clock::now() - scheduled_);
+    connect(endpoints_);
+}
+
+void Connection::close() {
+    beast::error_code ec;
+    stream_.socket().shutdown(tcp::socket::shutdown_both, ec);
+    stream_.close();
+    buffer_.clear();
+}
+
+LoadGenerator::LoadGenerator(Options options) :
+    options_(std::move(options)), arrivalTimer_(ioContext_), drainTimer_(ioContext_), numbers_(options_) {
+    report_.options = options_;
+}
+
+Report LoadGenerator::run() {
+    tcp::resolver resolver(ioContext_);
+    auto endpoints = resolver.resolve(options_.host, options_.port);
+
+    start_ = Clock::now();
+    end_ = start_ + options_.duration;
+    lastResponse_ = start_;
+    for (unsigned i = 0; i < options_.connections; ++i) {
+        connections_.push_back(std::make_shared<Connection>(*this, ioContext_));
+        connections_.back()->connect(endpoints);
+    }
+    if (options_.mode == Mode::Open)
+        scheduleArrival();
+
+    drainTimer_.expires_at(end_);
+    drainTimer_.async_wait([this](beast::error_code ec) {
+        if (ec)
+            return;
+        draining_ = true;
+        arrivalTimer_.cancel();
+        maybeFinish();
+        drainTimer_.expires_at(end_ + options_.drain);
+        drainTimer_.async_wait([this](beast::error_code ec) {
+            if (!ec)
+                ioContext_.stop();
+        });
+    });
+
+    ioContext_.run();
+
+    report_.elapsed = lastResponse_ - start_;
+    report_.unfinished = inFlight_ + backlog_.size();
+    return std::move(report_);
+}
+
+bool LoadGenerator::loadActive() const {
+    return !draining_ && (options_.requests == 0 || report_.sent < options_.requests);
+}
+
+void LoadGenerator::onIdle(const std::shared_ptr<Connection>& connection) {
+    if (!backlog_.empty()) {
+        auto scheduled = backlog_.front();
+        backlog_.pop_front();
+        ++report_.sent;
+        ++inFlight_;
+        return connection->send(numbers_.next(), scheduled);
+    }
+    if (options_.mode == Mode::Closed && loadActive()) {
+        ++report_.sent;
+        ++inFlight_;
+        return connection->send(numbers_.next(), Clock::now());
+    }
+    idle_.push_back(connection);
+    maybeFinish();
+}
+
+void LoadGenerator::onResponse(std::size_t outcome, Clock::duration latency) {
+    --inFlight_;
+    lastResponse_ = Clock::now();
+    report_.latency[outcome]->record(std::chrono::duration_cast<std::chrono::microseconds>(latency));
+}
+
+void LoadGenerator::scheduleArrival() {
+    auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / options_.rate));
+    auto next = start_ + interval * static_cast<Clock::rep>(arrivals_);
+    if (next >= end_)
+        return;
+    arrivalTimer_.expires_at(next);
+    arrivalTimer_.async_wait([this](beast::error_code ec) {
+        if (!ec)
+            onArrival();
+    });
+}
+
+void LoadGenerator::onArrival() {
+    auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / options_.rate));
+    auto now = Clock::now();
+    for (auto scheduled = start_ + interval * static_cast<Clock::rep>(arrivals_);
+         scheduled <= now && scheduled < end_;
+         scheduled = start_ + interval * static_cast<Clock::rep>(arrivals_)) {
+        ++arrivals_;
+        if (idle_.empty()) {
+            backlog_.push_back(scheduled);
+            continue;
+        }
+        auto connection = std::move(idle_.back());
+        idle_.pop_back();
+        ++report_.sent;
+        ++inFlight_;
+        connection->send(numbers_.next(), scheduled);
+    }
+    scheduleArrival();
+}
+
+void LoadGenerator::maybeFinish() {
+    bool loadOver = draining_ || (options_.mode == Mode::Closed && !loadActive());
+    if (!loadOver || inFlight_ != 0 || !backlog_.empty())
+        return;
+    arrivalTimer_.cancel();
+    drainTimer_.cancel();
+    for (auto& connection: connections_)
+        connection->close();
+    ioContext_.stop();
+}
@@ -0,0 +1,244 @@
+#ifndef PROTEI_COV_LOADGENERATOR_HPP
+#define PROTEI_COV_LOADGENERATOR_HPP
+#include <boost/asio.hpp>
+#include <boost/beast.hpp>
+#include <array>
+#include <deque>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "latencyHistogram.hpp"
+
+/**
+ * @file loadGenerator.hpp
+ * @brief Содержит объявление генератора нагрузки protei_cov_bench
+ */
+
+namespace bench {
+namespace asio = boost::asio;
+namespace beast = boost::beast;
+using tcp = asio::ip::tcp;
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Режим подачи нагрузки.
+ */
+enum class Mode {
+    Open, ///< Запросы поступают с постоянной частотой независимо от ответов сервера.
+    Closed ///< Каждое соединение отправляет следующий запрос сразу после ответа на предыдущий.
+};
+
+/**
+ * @brief Распределение номеров звонящих.
+ */
+enum class Distribution {
+    Sequential, ///< Каждый запрос с новым номером, повторных вызовов нет.
+    Uniform, ///< Номера равномерно выбираются из Numbers значений.
+    Zipf ///< Номера выбираются из Numbers значений по закону Ципфа, популярные номера дают повторные вызовы.
+};
+
+/**
+ * @brief Параметры генератора нагрузки.
+ */
+struct Options {
+    std::string host = "127.0.0.1"; ///< Адрес сервера.
+    std::string port = "8080"; ///< Порт сервера.
+    Mode mode = Mode::Closed; ///< Режим подачи нагрузки.
+    unsigned connections = 64; ///< Количество постоянных соединений.
+    double rate = 100; ///< Частота запросов в секунду в открытом режиме.
+    std::chrono::seconds duration{10}; ///< Время подачи нагрузки.
+    std::chrono::seconds drain{30}; ///< Сколько ждать ответов на отправленные запросы после окончания нагрузки.
+    std::uint64_t requests = 0; ///< Ограничение количества запросов в закрытом режиме, 0 - без ограничения.
+    Distribution distribution = Distribution::Sequential; ///< Распределение номеров звонящих.
+    std::uint64_t numbers = 1000; ///< Количество различных номеров для Uniform и Zipf.
+    double zipfExponent = 1.0; ///< Показатель распределения Ципфа.
+    std::uint64_t seed = 1; ///< Начальное значение генератора случайных чисел.
+
+    /**
+     * @brief Разбирает аргументы командной строки вида --key=value.
+     * @param argc Количество аргументов.
+     * @param argv Аргументы.
+     * @return Параметры генератора.
+     * @throws std::invalid_argument При неизвестном аргументе или неверном значении.
+     */
+    static Options parse(int argc, const char* argv[]);
+
+    /**
+     * @brief Возвращает описание аргументов командной строки.
+     * @return Текст справки.
+     */
+    static std::string usage();
+};
+
+/**
+ * @brief Генератор номеров звонящих по заданному распределению.
+ */
+class CallerNumbers {
+public:
+    /**
+     * @brief Конструктор CallerNumbers.
+     * @param options Параметры генератора нагрузки.
+     */
+    explicit CallerNumbers(const Options& options);
+
+    /**
+     * @brief Возвращает номер для следующего запроса.
+     * @return Номер звонящего.
+     */
+    std::uint64_t next();
+
+private:
+    Distribution distribution_; ///< Распределение номеров.
+    std::uint64_t sequence_ = 0; ///< Следующий номер для Sequential.
+    std::mt19937_64 rng_; ///< Генератор случайных чисел.
+    std::uniform_int_distribution<std::uint64_t> uniform_; ///< Распределение для Uniform.
+    std::vector<double> zipfCdf_; ///< Функция распределения для Zipf.
+};
+
+/**
+ * @brief Итог измерения.
+ */
+struct Report {
+    static constexpr std::size_t outcomeCount = 7; ///< Шесть значений CallStatus и ошибки соединения.
+
+    Options options; ///< Параметры, с которыми проводилось измерение.
+    Clock::duration elapsed{}; ///< Время от начала нагрузки до последнего ответа.
+    std::uint64_t sent = 0; ///< Отправлено запросов.
+    std::uint64_t unfinished = 0; ///< Запросов без ответа к концу ожидания.
+    std::array<std::unique_ptr<utility::LatencyHistogram>, outcomeCount> latency; ///< Задержки по исходам.
+
+    /// @brief Создает пустые гистограммы.
+    Report();
+
+    /**
+     * @brief Выводит пропускную способность и перцентили задержек по статусам.
+     * @param out Поток вывода.
+     */
+    void print(std::ostream& out) const;
+};
+
+class LoadGenerator;
+
+/**
+ * @brief Постоянное соединение с сервером, по которому запросы отправляются по одному.
+ */
+class Connection : public std::enable_shared_from_this<Connection> {
+public:
+    /**
+     * @brief Конструктор Connection.
+     * @param generator Генератор, которому сообщается о готовности соединения и об ответах.
+     * @param ioContext Контекст ввода-вывода.
+     */
+    Connection(LoadGenerator& generator, asio::io_context& ioContext);
+
+    /**
+     * @brief Устанавливает соединение, по готовности сообщает генератору.
+     * @param endpoints Адреса сервера.
+     */
+    void connect(const tcp::resolver::results_type& endpoints);
+
+    /**
+     * @brief Отправляет запрос вызова.
+     * @param number Номер звонящего.
+     * @param scheduled Время, когда запрос должен был быть отправлен, от него отсчитывается задержка.
+     */
+    void send(std::uint64_t number, Clock::time_point scheduled);
+
+    /// @brief Закрывает соединение.
+    void close();
+
+private:
+    void onConnect(beast::error_code ec);
+    void onWrite(beast::error_code ec, std::size_t);
+    void onRead(beast::error_code ec, std::size_t);
+
+    /**
+     * @brief Завершает запрос ошибкой и переподключается.
+     * @param ec Код ошибки.
+     */
+    void fail(beast::error_code ec);
+
+    LoadGenerator& generator_; ///< Генератор нагрузки.
+    beast::tcp_stream stream_; ///< Поток TCP.
+    beast::flat_buffer buffer_; ///< Буфер чтения.
+    beast::http::request<beast::http::empty_body> request_; ///< Текущий запрос.
+    beast::http::response<beast::http::string_body> response_; ///< Текущий ответ.
+    tcp::resolver::results_type endpoints_; ///< Адреса сервера для переподключения.
+    Clock::time_point scheduled_; ///< Время отправки текущего запроса по расписанию.
+    bool busy_ = false; ///< Ожидается ответ на запрос.
+};
+
+/**
+ * @brief Класс LoadGenerator – генератор нагрузки на Boost.Beast с постоянными соединениями.
+ * В открытом режиме запросы поступают по расписанию с постоянной частотой. Если свободного соединения нет,
+ * запрос ждет в очереди, а задержка все равно отсчитывается от времени по расписанию, поэтому медленный
+ * сервер не снижает нагрузку незаметно для измерения (coordinated omission).
+ * В закрытом режиме каждое соединение отправляет следующий запрос сразу после ответа.
+ * Все соединения обслуживаются одним потоком ввода-вывода.
+ */
+class LoadGenerator {
+public:
+    /**
+     * @brief Конструктор LoadGenerator.
+     * @param options Параметры генератора нагрузки.
+     */
+    explicit LoadGenerator(Options options);
+
+    /**
+     * @brief Подает нагрузку и дожидается ответов.
+     * @return Итог измерения.
+     */
+    Report run();
+
+private:
+    friend class Connection;
+
+    /**
+     * @brief Соединение готово отправить запрос.
+     * @param connection Соединение.
+     */
+    void onIdle(const std::shared_ptr<Connection>& connection);
+
+    /**
+     * @brief Учитывает ответ или ошибку.
+     * @param outcome Номер исхода: значение CallStatus или ошибка соединения.
+     * @param latency Задержка от времени по расписанию.
+     */
+    void onResponse(std::size_t outcome, Clock::duration latency);
+
+    /// @brief Запускает таймер следующего поступления в открытом режиме.
+    void scheduleArrival();
+
+    /// @brief Отправляет запросы, время которых по расписанию уже наступило.
+    void onArrival();
+
+    /// @brief Проверяет, закончено ли измерение, и останавливает контекст.
+    void maybeFinish();
+
+    /**
+     * @brief Проверяет, можно ли еще отправлять запросы.
+     * @return true, если время и лимит запросов не исчерпаны.
+     */
+    bool loadActive() const;
+
+    Options options_; ///< Параметры генератора.
+    asio::io_context ioContext_; ///< Контекст ввода-вывода.
+    asio::steady_timer arrivalTimer_; ///< Таймер поступления запросов в открытом режиме.
+    asio::steady_timer drainTimer_; ///< Таймер окончания ожидания ответов.
+    CallerNumbers numbers_; ///< Номера звонящих.
+    std::vector<std::shared_ptr<Connection>> connections_; ///< Все соединения.
+    std::vector<std::shared_ptr<Connection>> idle_; ///< Свободные соединения.
+    std::deque<Clock::time_point> backlog_; ///< Поступившие запросы, ждущие свободного соединения.
+    Clock::time_point start_; ///< Начало нагрузки.
+    Clock::time_point end_; ///< Окончание нагрузки.
+    Clock::time_point lastResponse_; ///< Время последнего ответа.
+    std::uint64_t arrivals_ = 0; ///< Количество поступлений по расписанию.
+    std::uint64_t inFlight_ = 0; ///< Запросов без ответа.
+    bool draining_ = false; ///< Нагрузка закончилась, ожидаются ответы.
+    Report report_; ///< Итог измерения.
+};
+}
+#endif // PROTEI_COV_LOADGENERATOR_HPP
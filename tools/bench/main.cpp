@@ -0,0 +1,19 @@
+#include "loadGenerator.hpp"
+
+#include <cstring>
+#include <iostream>
+
+int main(int argc, const char* argv[]) {
+    if (argc == 2 && (!strcmp(argv[1], "--help") || !strcmp(argv[1], "-h"))) {
+        std::cout << bench::Options::usage();
+        return 0;
+    }
+    try {
+        bench::LoadGenerator generator(bench::Options::parse(argc, argv));
+        generator.run().print(std::cout);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n' << bench::Options::usage();
+        return 1;
+    }
+    return 0;
+}